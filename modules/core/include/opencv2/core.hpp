@@ -215,7 +215,17 @@ enum KmeansFlags {
         user-supplied labels instead of computing them from the initial centers. For the second and
         further attempts, use the random or semi-random centers. Use one of KMEANS_\*_CENTERS flag
         to specify the exact method.*/
-    KMEANS_USE_INITIAL_LABELS = 1
+    KMEANS_USE_INITIAL_LABELS = 1,
+    /** Use triangle inequality bounds (G. Hamerly, Making k-means even faster, 2010) to skip most of
+        point-to-center distance computations. The result is the same as without the flag, up to
+        points equidistant from several centers. Needs 16 bytes of extra memory per sample.*/
+    KMEANS_ACCELERATED        = 4,
+    /** Mini-batch k-means (D. Sculley, Web-scale k-means clustering, 2010): each iteration updates
+        the centers by a random subset of samples (1024 by default, see OPENCV_KMEANS_MINI_BATCH_SIZE),
+        so the centers are approximate. criteria.maxCount is the number of mini-batches, it is not limited
+        by 100. Initial centers are chosen from a random subset of samples as well, and the labels are
+        computed by the final pass over all samples.*/
+    KMEANS_MINI_BATCH         = 8
 };
 
 //! @} core_cluster
@@ -2017,6 +2027,26 @@ stores the indices of sorted elements in the output array. For example:
 */
 CV_EXPORTS_W void sortIdx(InputArray src, OutputArray dst, int flags);
 
+/** @brief Finds the k smallest or the k largest elements in each row or each column of a matrix.
+
+The function selects the elements without sorting the whole rows (columns), which is much
+faster than cv::sort or cv::sortIdx when k is small. The selected elements are returned in the
+order given by the flags; the equal elements are ordered by their positions. For example, with
+SORT_EVERY_ROW + SORT_DESCENDING the row i of values contains the k largest elements of the row i
+of src, in the descending order, and the row i of indices contains their column indices.
+@param src input single-channel array.
+@param values output array of the selected elements of the same type as src. It has k columns
+(SORT_EVERY_ROW) or k rows (SORT_EVERY_COLUMN). It can be omitted with noArray().
+@param indices output CV_32S array of the positions of the selected elements within their rows
+(columns), of the same size as values. It can be omitted with noArray().
+@param k number of the elements to select, 1 <= k <= row (column) length.
+@param flags operation flags that could be a combination of cv::SortFlags; SORT_DESCENDING selects
+the largest elements and SORT_ASCENDING selects the smallest ones.
+@sa sort, sortIdx
+*/
+CV_EXPORTS_W void topK(InputArray src, OutputArray values, OutputArray indices, int k,
+                       int flags = SORT_EVERY_ROW + SORT_DESCENDING);
+
 /** @brief Finds the real roots of a cubic equation.
 
 The function solveCubic finds the real roots of a cubic equation:
@@ -2301,6 +2331,62 @@ the convolution sample in dft description.
 */
 CV_EXPORTS_W void idft(InputArray src, OutputArray dst, int flags = 0, int nonzeroRows = 0);
 
+/** @brief Precomputed discrete Fourier transform of arrays of a fixed size and type.
+
+The plan computes factorization of the transform size, twiddle factors and work buffers once, so
+repeated transforms of same-size arrays don't pay the setup cost of cv::dft on every call.
+Results are the same as of cv::dft with the same flags.
+
+A plan is immutable, execute() may be called concurrently from several threads. create() returns
+a shared plan if the same plan was created recently (see OPENCV_DFT_PLAN_CACHE_SIZE).
+@sa dft
+*/
+class CV_EXPORTS DFTPlan
+{
+public:
+    virtual ~DFTPlan();
+
+    /** @brief Creates the plan.
+    @param size size of source arrays.
+    @param type type of source arrays: CV_32FC1, CV_32FC2, CV_64FC1 or CV_64FC2.
+    @param flags transformation flags, see cv::dft.
+    @param nonzeroRows see cv::dft.
+    */
+    static Ptr<DFTPlan> create(Size size, int type, int flags = 0, int nonzeroRows = 0);
+
+    /** @brief Transforms the array, the same as dft(src, dst, flags, nonzeroRows) with the plan parameters.
+    @param src input array of the plan size and type.
+    @param dst output array, its size and type are determined by the plan.
+    */
+    virtual void execute(InputArray src, OutputArray dst) const = 0;
+
+    /** @brief Transforms each array of the batch, the arrays are processed in parallel.
+    @param src vector of input arrays of the plan size and type, or 3D array (count x rows x cols)
+    of the plan type.
+    @param dst vector of output arrays or 3D array, the same as src. May be the same as src for
+    in-place transform.
+    */
+    virtual void executeBatch(InputArrayOfArrays src, OutputArrayOfArrays dst) const = 0;
+
+    virtual Size size() const = 0;      //!< size of source arrays
+    virtual int type() const = 0;       //!< type of source arrays
+    virtual int dstType() const = 0;    //!< type of output arrays
+    virtual int flags() const = 0;      //!< transformation flags
+};
+
+/** @brief Performs a forward or inverse Discrete Fourier transform of each array of the batch.
+
+The function is equivalent to calling cv::dft for each of the arrays, but the transform setup is
+done once and the arrays are processed in parallel. It is useful for many small arrays (e.g. image
+tiles), where the transform of a single array is too small to be parallelized.
+@param src vector of arrays of the same size and type, or 3D array (count x rows x cols).
+@param dst output vector of arrays or 3D array, the same as src.
+@param flags transformation flags, see cv::dft.
+@param nonzeroRows see cv::dft.
+@sa DFTPlan
+*/
+CV_EXPORTS void dftBatch(InputArrayOfArrays src, OutputArrayOfArrays dst, int flags = 0, int nonzeroRows = 0);
+
 /** @brief Performs a forward or inverse discrete Cosine transform of 1D or 2D array.
 
 The function cv::dct performs a forward or inverse discrete Cosine transform (DCT) of a 1D or 2D
@@ -2522,7 +2608,12 @@ class CV_EXPORTS PCA
 public:
     enum Flags { DATA_AS_ROW = 0, //!< indicates that the input samples are stored as matrix rows
                  DATA_AS_COL = 1, //!< indicates that the input samples are stored as matrix columns
-                 USE_AVG     = 2  //!
+                 USE_AVG     = 2, //!
+                 /** computes only maxComponents components by randomized truncated SVD (N. Halko et al.,
+                     Finding structure with randomness, 2011), without forming the covariance matrix.
+                     The data is read only via matrix products, a few times. Used when maxComponents
+                     is much less than the data dimensionality and the number of samples. */
+                 RANDOMIZED  = 4
                };
 
     /** @brief default constructor
@@ -2536,8 +2627,8 @@ public:
     @param data input samples stored as matrix rows or matrix columns.
     @param mean optional mean value; if the matrix is empty (@c noArray()),
     the mean is computed from the data.
-    @param flags operation flags; currently the parameter is only used to
-    specify the data layout (PCA::Flags)
+    @param flags operation flags; specify the data layout and the PCA::RANDOMIZED
+    mode (PCA::Flags)
     @param maxComponents maximum number of components that %PCA should
     retain; by default, all the components are retained.
     */
@@ -2570,8 +2661,8 @@ public:
     columns.
     @param mean optional mean value; if the matrix is empty (noArray()),
     the mean is computed from the data.
-    @param flags operation flags; currently the parameter is only used to
-    specify the data layout. (Flags)
+    @param flags operation flags; specify the data layout and the PCA::RANDOMIZED
+    mode. (Flags)
     @param maxComponents maximum number of components that PCA should
     retain; by default, all the components are retained.
     */
@@ -2590,6 +2681,21 @@ public:
      */
     PCA& operator()(InputArray data, InputArray mean, int flags, double retainedVariance);
 
+    /** @brief Updates %PCA by a new batch of samples (incremental %PCA).
+
+    The method updates @ref mean, @ref eigenvalues and @ref eigenvectors as if %PCA was computed from
+    all the samples seen so far, but only the retained components are kept between the calls, so the
+    result is an approximation when some components were dropped. The cost of the update is linear
+    in the batch size. If the structure is empty, the method performs the regular %PCA of the batch.
+
+    @param data new samples stored as the matrix rows or as the matrix columns, the layout must
+    be the same as of the data used to compute the current components.
+    @param flags operation flags (PCA::Flags), only the data layout is used.
+    @param maxComponents maximum number of components to retain; by default, the current number of
+    components is retained (all the components for the first batch).
+     */
+    PCA& update(InputArray data, int flags = DATA_AS_ROW, int maxComponents = 0);
+
     /** @brief Projects vector(s) to the principal component subspace.
 
     The methods project one or more vectors to the principal component
@@ -2659,6 +2765,7 @@ public:
     Mat eigenvectors; //!< eigenvectors of the covariation matrix
     Mat eigenvalues; //!< eigenvalues of the covariation matrix
     Mat mean; //!< mean value subtracted before the projection and added after the back projection
+    int64 nsamples; //!< number of samples the components are computed from, used by update()
 };
 
 /** @example samples/cpp/pca.cpp
@@ -3027,6 +3134,9 @@ public:
     generates samples from multi-dimensional standard Gaussian distribution
     with zero mean and identity covariation matrix, and then transforms them
     using transform to get samples from the specified Gaussian distribution.
+
+    Large arrays are filled in parallel. The generated values and the resulting
+    RNG state do not depend on the number of threads.
     */
     void fill( InputOutputArray mat, int distType, InputArray a, InputArray b, bool saturateRange = false );
 
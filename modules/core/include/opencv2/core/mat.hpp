@@ -2148,6 +2148,8 @@ public:
     MatAllocator* allocator;
     //! and the standard allocator
     static MatAllocator* getStdAllocator();
+    //! the pooling allocator which reuses released buffers (see BufferPoolController)
+    static MatAllocator* getBufferPoolAllocator();
     static MatAllocator* getDefaultAllocator();
     static void setDefaultAllocator(MatAllocator* allocator);
 
@@ -3495,6 +3497,8 @@ protected:
 
 ///////////////////////////////// Matrix Expressions /////////////////////////////////
 
+struct MatExprNode;
+
 class CV_EXPORTS MatOp
 {
 public:
@@ -3619,6 +3623,9 @@ public:
     Mat a, b, c;
     double alpha, beta;
     Scalar s;
+
+    //! internal use: element-wise operations tree of the fused expression
+    Ptr<MatExprNode> node;
 };
 
 //! @} core_basic
@@ -316,9 +316,16 @@ public:
         FORMAT_XML  = (1<<3), //!< flag, XML format
         FORMAT_YAML = (2<<3), //!< flag, YAML format
         FORMAT_JSON = (3<<3), //!< flag, JSON format
+        FORMAT_BINARY = (4<<3), /**< flag, compact binary format. Must be specified explicitly for writing,
+                                     it is detected automatically on reading. Numeric arrays are stored
+                                     aligned, and matrices read from a memory-mapped file are views of
+                                     the file data (copy-on-write) */
 
         BASE64      = 64,     //!< flag, write rawdata in Base64 by default. (consider using WRITE_BASE64)
         WRITE_BASE64 = BASE64 | WRITE, //!< flag, enable both WRITE and BASE64
+        LAZY        = 128,    /**< flag, read mode only: memory-map the file and defer decoding of large
+                                   Base64 payloads until they are accessed. FileNode::readRaw() decodes
+                                   such payloads directly into the destination buffer */
     };
     enum State
     {
@@ -22,6 +22,11 @@ public:
 
     /** set peak usage = current usage */
     virtual void resetPeakUsage() = 0;
+
+    /** number of allocations served from reserved buffers (pooling allocators only) */
+    virtual uint64_t getNumberOfPoolHits() const { return 0; }
+    /** number of allocations which required new buffers from the system (pooling allocators only) */
+    virtual uint64_t getNumberOfPoolMisses() const { return 0; }
 };
 
 }} // namespace
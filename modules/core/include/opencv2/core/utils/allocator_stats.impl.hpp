@@ -48,14 +48,17 @@ public:
 
     void onAllocate(size_t /*sz*/) {}
     void onFree(size_t /*sz*/) {}
+    void onPoolHit() {}
+    void onPoolMiss() {}
 
 #else
 
 protected:
     typedef OPENCV_ALLOCATOR_STATS_COUNTER_TYPE counter_t;
     std::atomic<counter_t> curr, total, total_allocs, peak;
+    std::atomic<counter_t> pool_hits, pool_misses;
 public:
-    AllocatorStatistics() {}
+    AllocatorStatistics() : curr(0), total(0), total_allocs(0), peak(0), pool_hits(0), pool_misses(0) {}
     ~AllocatorStatistics() CV_OVERRIDE {}
 
     uint64_t getCurrentUsage() const CV_OVERRIDE { return (uint64_t)curr.load(); }
@@ -66,6 +69,9 @@ public:
     /** set peak usage = current usage */
     void resetPeakUsage() CV_OVERRIDE { peak.store(curr.load()); }
 
+    uint64_t getNumberOfPoolHits() const CV_OVERRIDE { return (uint64_t)pool_hits.load(); }
+    uint64_t getNumberOfPoolMisses() const CV_OVERRIDE { return (uint64_t)pool_misses.load(); }
+
     // Controller interface
     void onAllocate(size_t sz)
     {
@@ -94,6 +100,8 @@ public:
 #endif
         curr -= (counter_t)sz;
     }
+    void onPoolHit() { pool_hits++; }
+    void onPoolMiss() { pool_misses++; }
 #endif // OPENCV_DISABLE_ALLOCATOR_STATS
 };
 
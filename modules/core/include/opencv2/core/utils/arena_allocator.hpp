@@ -0,0 +1,75 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_UTILS_ARENA_ALLOCATOR_HPP
+#define OPENCV_CORE_UTILS_ARENA_ALLOCATOR_HPP
+
+#include "opencv2/core/mat.hpp"
+#include "opencv2/core/utils/allocator_stats.hpp"
+
+namespace cv { namespace utils {
+
+//! @addtogroup core_utils
+//! @{
+
+/** @brief Pooling Mat allocator for short-living temporary buffers
+
+Released buffers are not returned to the system. They are reserved (in LRU order) and reused by the next
+allocations of the same size class, so steady state of per-frame processing doesn't call malloc/free
+and doesn't trigger page faults. Buffers larger than 1/8 of the limit are not reserved.
+
+The pool is controlled via getBufferPoolController() like OpenCL buffer pools.
+
+Allocator is thread-safe: buffers may be released by any thread.
+Use MatAllocatorScope to make it the default allocator of Mat objects created by the current thread.
+
+@note Allocator object must outlive all matrices allocated by it.
+@note Mat keeps its allocator, so matrices created under the scope keep using this allocator on re-creation.
+*/
+class CV_EXPORTS ArenaMatAllocator : public MatAllocator
+{
+public:
+    struct CV_EXPORTS Params
+    {
+        Params();
+
+        size_t maxReservedSize;  //!< limit of reserved memory (bytes)
+        bool prefault;           //!< touch pages of new buffers during allocation
+        bool hugePages;          //!< request transparent huge pages for large buffers (Linux only)
+    };
+
+    static Ptr<ArenaMatAllocator> create(const Params& params = Params());
+
+    /** @brief Returns memory usage statistics, including pool hits and misses */
+    virtual const AllocatorStatisticsInterface& getStatistics() const = 0;
+
+    /** @brief Returns amount of reserved memory (bytes) */
+    virtual size_t getReservedSize() const = 0;
+
+    /** @brief Returns all reserved buffers to the system */
+    virtual void freeAllReservedBuffers() = 0;
+};
+
+/** @brief Makes the allocator default for Mat objects created by the current thread while the scope object exists
+
+Scopes may be nested. Other threads are not affected.
+*/
+class CV_EXPORTS MatAllocatorScope
+{
+public:
+    explicit MatAllocatorScope(MatAllocator* allocator);
+    ~MatAllocatorScope();
+
+private:
+    MatAllocator* prevAllocator_;
+
+    MatAllocatorScope(const MatAllocatorScope&); // disabled
+    MatAllocatorScope& operator=(const MatAllocatorScope&); // disabled
+};
+
+//! @}
+
+}} // namespace
+
+#endif // OPENCV_CORE_UTILS_ARENA_ALLOCATOR_HPP
@@ -422,6 +422,18 @@ PERF_TEST_P_(BinaryOpTest, reciprocal)
     SANITY_CHECK_NOTHING();
 }
 
+PERF_TEST_P_(BinaryOpTest, matExprFused)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    cv::Mat a(sz, type), b(sz, type), c(sz, type), d(sz, type), dst(sz, type);
+
+    declare.in(a, b, c, d, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() dst = (a - b).mul(c) * 0.5 + d;
+
+    SANITY_CHECK_NOTHING();
+}
 
 PERF_TEST_P_(BinaryOpTest, transposeND)
 {
@@ -733,6 +745,56 @@ INSTANTIATE_TEST_CASE_P(/*nothing*/ , RotateTest,
 );
 
 
+///////////// Transpose, Flip ////////////////////////
+
+typedef perf::TestBaseWithParam<std::tuple<cv::Size, perf::MatType>> TransposeTest;
+
+PERF_TEST_P_(TransposeTest, transpose)
+{
+    Size sz  = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    cv::Mat a(sz, type), b(sz.width, sz.height, type);
+
+    declare.in(a, WARMUP_RNG).out(b);
+
+    TEST_CYCLE() cv::transpose(a, b);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(TransposeTest, transpose_inplace)
+{
+    Size sz  = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    cv::Mat a(sz.height, sz.height, type);
+
+    declare.in(a, WARMUP_RNG).out(a);
+
+    TEST_CYCLE() cv::transpose(a, a);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(TransposeTest, flip_both)
+{
+    Size sz  = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    cv::Mat a(sz, type), b(sz, type);
+
+    declare.in(a, WARMUP_RNG).out(b);
+
+    TEST_CYCLE() cv::flip(a, b, -1);
+
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/ , TransposeTest,
+    testing::Combine(
+        testing::Values(sz1080p, Size(3840, 2160)),
+        testing::Values(CV_8UC1, CV_8UC3, CV_8UC4, CV_16UC1, CV_32FC1, CV_32FC3)
+    )
+);
+
 ///////////// PatchNaNs ////////////////////////
 
 template<typename _Tp>
@@ -36,6 +36,67 @@ PERF_TEST_P(Size_MatType_FlagsType_NzeroRows, dft, TEST_MATS_DFT)
     SANITY_CHECK(dst, 1e-5, ERROR_RELATIVE);
 }
 
+typedef tuple<Size, MatType> Size_MatType_DFTPlan_t;
+typedef perf::TestBaseWithParam<Size_MatType_DFTPlan_t> Size_MatType_DFTPlan;
+
+PERF_TEST_P(Size_MatType_DFTPlan, dft_plan, testing::Combine(
+                testing::Values(cv::Size(32, 32), cv::Size(64, 64), cv::Size(128, 128), cv::Size(320, 240)),
+                testing::Values(CV_32FC1, CV_32FC2)))
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+
+    Mat src(sz, type);
+    Mat dst(sz, type);
+
+    declare.in(src, WARMUP_RNG);
+
+    Ptr<DFTPlan> plan = DFTPlan::create(sz, type);
+    TEST_CYCLE_N(1000) plan->execute(src, dst);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(Size_MatType_DFTPlan, dft_plan_baseline, testing::Combine(
+                testing::Values(cv::Size(32, 32), cv::Size(64, 64), cv::Size(128, 128), cv::Size(320, 240)),
+                testing::Values(CV_32FC1, CV_32FC2)))
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+
+    Mat src(sz, type);
+    Mat dst(sz, type);
+
+    declare.in(src, WARMUP_RNG);
+
+    TEST_CYCLE_N(1000) dft(src, dst);
+
+    SANITY_CHECK_NOTHING();
+}
+
+typedef tuple<int, Size, MatType> Count_Size_MatType_t;
+typedef perf::TestBaseWithParam<Count_Size_MatType_t> Count_Size_MatType;
+
+PERF_TEST_P(Count_Size_MatType, dft_batch, testing::Combine(
+                testing::Values(16, 256),
+                testing::Values(cv::Size(32, 32), cv::Size(64, 64)),
+                testing::Values(CV_32FC1, CV_32FC2)))
+{
+    int count = get<0>(GetParam());
+    Size sz = get<1>(GetParam());
+    int type = get<2>(GetParam());
+    int sizes[] = { count, sz.height, sz.width };
+
+    Mat src(3, sizes, type);
+    Mat dst(3, sizes, type);
+
+    declare.in(src, WARMUP_RNG);
+
+    TEST_CYCLE() dftBatch(src, dst);
+
+    SANITY_CHECK_NOTHING();
+}
+
 ///////////////////////////////////////////////////////dct//////////////////////////////////////////////////////
 
 CV_ENUM(DCT_FlagsType, 0, DCT_INVERSE , DCT_ROWS, DCT_INVERSE|DCT_ROWS)
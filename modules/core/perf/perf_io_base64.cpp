@@ -83,4 +83,93 @@ PERF_TEST_P(Size_Mat_StrType, DISABLED_fs_base64,
     SANITY_CHECK_NOTHING();
 }
 
+PERF_TEST_P(Size_Mat_StrType, fs_base64_encode,
+            testing::Combine(testing::Values(MAT_SIZES),
+                             testing::Values(MAT_TYPES),
+                             testing::Values(FILE_EXTENSION))
+             )
+{
+    Size   size = get<0>(GetParam());
+    int    type = get<1>(GetParam());
+    String ext  = get<2>(GetParam());
+
+    Mat src(size.height, size.width, type);
+    declare.in(src, WARMUP_RNG);
+
+    cv::String file_name = cv::tempfile(ext.c_str());
+    TEST_CYCLE()
+    {
+        FileStorage fs(file_name, cv::FileStorage::WRITE_BASE64);
+        fs << "test_mat" << src;
+        fs.release();
+    }
+
+    remove(file_name.c_str());
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(Size_Mat_StrType, fs_base64_decode,
+            testing::Combine(testing::Values(MAT_SIZES),
+                             testing::Values(MAT_TYPES),
+                             testing::Values(FILE_EXTENSION))
+             )
+{
+    Size   size = get<0>(GetParam());
+    int    type = get<1>(GetParam());
+    String ext  = get<2>(GetParam());
+
+    Mat src(size.height, size.width, type);
+    Mat dst = src.clone();
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    std::string content;
+    {
+        FileStorage fs(ext, cv::FileStorage::WRITE_BASE64 + cv::FileStorage::MEMORY);
+        fs << "test_mat" << src;
+        content = fs.releaseAndGetString();
+    }
+
+    // deferred payload is decoded directly to the matrix, without creation of nodes
+    TEST_CYCLE()
+    {
+        FileStorage fs(content, cv::FileStorage::READ + cv::FileStorage::MEMORY + cv::FileStorage::LAZY);
+        fs["test_mat"] >> dst;
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(Size_MatType, DISABLED_fs_binary,
+            testing::Combine(testing::Values(MAT_SIZES),
+                             testing::Values(MAT_TYPES))
+             )
+{
+    Size   size = get<0>(GetParam());
+    int    type = get<1>(GetParam());
+
+    Mat src(size.height, size.width, type);
+    Mat dst = src.clone();
+
+    cv::String file_name = cv::tempfile(".bin");
+    cv::String key       = "test_mat";
+
+    declare.in(src, WARMUP_RNG).out(dst);
+    TEST_CYCLE_MULTIRUN(2)
+    {
+        {
+            FileStorage fs(file_name, cv::FileStorage::WRITE + cv::FileStorage::FORMAT_BINARY);
+            fs << key << src;
+            fs.release();
+        }
+        {
+            FileStorage fs(file_name, cv::FileStorage::READ);
+            fs[key] >> dst;
+            fs.release();
+        }
+    }
+
+    remove(file_name.c_str());
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
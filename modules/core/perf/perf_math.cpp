@@ -180,6 +180,79 @@ PERF_TEST_P(SolveTest, randomMat, ::testing::Combine(
     SANITY_CHECK_NOTHING();
 }
 
+typedef perf::TestBaseWithParam<std::tuple<int, MatDepth>> DecompLargeTest;
+
+PERF_TEST_P(DecompLargeTest, invert_LU, ::testing::Combine(
+    ::testing::Values(256, 512, 1024),
+    ::testing::Values(CV_32F, CV_64F)
+    ))
+{
+    int size  = std::get<0>(GetParam());
+    int depth = std::get<1>(GetParam());
+
+    Mat A(size, size, depth), dst;
+    declare.in(A, WARMUP_RNG);
+
+    TEST_CYCLE() cv::invert(A, dst, DECOMP_LU);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(DecompLargeTest, invert_Cholesky, ::testing::Combine(
+    ::testing::Values(256, 512, 1024),
+    ::testing::Values(CV_32F, CV_64F)
+    ))
+{
+    int size  = std::get<0>(GetParam());
+    int depth = std::get<1>(GetParam());
+
+    // symmetric positive definite matrix
+    Mat B(size, size, depth), A, dst;
+    randu(B, -1, 1);
+    mulTransposed(B, A, false);
+    A += Mat::eye(size, size, depth) * size;
+
+    TEST_CYCLE() cv::invert(A, dst, DECOMP_CHOLESKY);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(DecompLargeTest, svd, ::testing::Combine(
+    ::testing::Values(128, 256, 512),
+    ::testing::Values(CV_32F, CV_64F)
+    ))
+{
+    int size  = std::get<0>(GetParam());
+    int depth = std::get<1>(GetParam());
+
+    Mat A(size, size, depth);
+    declare.in(A, WARMUP_RNG);
+
+    TEST_CYCLE() cv::SVD svd(A);
+
+    SANITY_CHECK_NOTHING();
+}
+
+typedef perf::TestBaseWithParam<std::tuple<int, MatDepth, int>> GemmTest;
+
+PERF_TEST_P(GemmTest, gemm, ::testing::Combine(
+    ::testing::Values(32, 128, 512),
+    ::testing::Values(CV_32F, CV_64F),
+    ::testing::Values(0, (int)GEMM_1_T, (int)GEMM_2_T)
+    ))
+{
+    int size  = std::get<0>(GetParam());
+    int depth = std::get<1>(GetParam());
+    int flags = std::get<2>(GetParam());
+
+    Mat A(size, size, depth), B(size, size, depth), C(size, size, depth), D(size, size, depth);
+    declare.in(A, B, C, WARMUP_RNG);
+
+    TEST_CYCLE() cv::gemm(A, B, 1.0, C, 0.5, D, flags);
+
+    SANITY_CHECK_NOTHING();
+}
+
 typedef perf::TestBaseWithParam<std::tuple<std::tuple<int, int>, RankEnum, MatDepth, bool, bool>> SvdTest;
 
 PERF_TEST_P(SvdTest, decompose, ::testing::Combine(
@@ -334,6 +407,74 @@ PERF_TEST_P_(KMeans, good)
     SANITY_CHECK_NOTHING();
 }
 
+PERF_TEST_P_(KMeans, good_accelerated)
+{
+    RNG& rng = theRNG();
+    const int K = testing::get<0>(GetParam());
+    const int dims = testing::get<1>(GetParam());
+    const int N = testing::get<2>(GetParam());
+    const int attempts = 5;
+
+    Mat data(N, dims, CV_32F);
+    rng.fill(data, RNG::UNIFORM, -0.1, 0.1);
+
+    const int N0 = K;
+    Mat data0(N0, dims, CV_32F);
+    rng.fill(data0, RNG::UNIFORM, -1, 1);
+
+    for (int i = 0; i < N; i++)
+    {
+        int base = rng.uniform(0, N0);
+        cv::add(data0.row(base), data.row(i), data.row(i));
+    }
+
+    declare.in(data);
+
+    Mat labels, centers;
+
+    TEST_CYCLE()
+    {
+        kmeans(data, K, labels, TermCriteria(TermCriteria::MAX_ITER+TermCriteria::EPS, 30, 0),
+               attempts, KMEANS_PP_CENTERS | KMEANS_ACCELERATED, centers);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(KMeans, good_mini_batch)
+{
+    RNG& rng = theRNG();
+    const int K = testing::get<0>(GetParam());
+    const int dims = testing::get<1>(GetParam());
+    const int N = testing::get<2>(GetParam());
+    const int attempts = 5;
+
+    Mat data(N, dims, CV_32F);
+    rng.fill(data, RNG::UNIFORM, -0.1, 0.1);
+
+    const int N0 = K;
+    Mat data0(N0, dims, CV_32F);
+    rng.fill(data0, RNG::UNIFORM, -1, 1);
+
+    for (int i = 0; i < N; i++)
+    {
+        int base = rng.uniform(0, N0);
+        cv::add(data0.row(base), data.row(i), data.row(i));
+    }
+
+    declare.in(data);
+
+    Mat labels, centers;
+
+    TEST_CYCLE()
+    {
+        kmeans(data, K, labels, TermCriteria(TermCriteria::MAX_ITER+TermCriteria::EPS, 30, 0),
+               attempts, KMEANS_PP_CENTERS | KMEANS_MINI_BATCH, centers);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 PERF_TEST_P_(KMeans, with_duplicates)
 {
     RNG& rng = theRNG();
@@ -387,4 +528,49 @@ INSTANTIATE_TEST_CASE_P(/*nothing*/ , KMeans,
 
 }
 
+typedef perf::TestBaseWithParam<std::tuple<std::tuple<int, int>, int, int>> PCATest;
+
+PERF_TEST_P(PCATest, compute, ::testing::Combine(
+    ::testing::Values(std::make_tuple(10000, 128), std::make_tuple(2000, 1024)),
+    ::testing::Values(10, 50),
+    ::testing::Values(0, (int)PCA::RANDOMIZED)
+    ))
+{
+    int samples = std::get<0>(std::get<0>(GetParam()));
+    int dims = std::get<1>(std::get<0>(GetParam()));
+    int maxComponents = std::get<1>(GetParam());
+    int flags = std::get<2>(GetParam());
+
+    Mat data(samples, dims, CV_32F);
+    declare.in(data, WARMUP_RNG);
+
+    PCA pca;
+    TEST_CYCLE() pca(data, noArray(), PCA::DATA_AS_ROW | flags, maxComponents);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(PCATest, update, ::testing::Combine(
+    ::testing::Values(std::make_tuple(1000, 128), std::make_tuple(1000, 1024)),
+    ::testing::Values(10, 50),
+    ::testing::Values(0)
+    ))
+{
+    int samples = std::get<0>(std::get<0>(GetParam()));
+    int dims = std::get<1>(std::get<0>(GetParam()));
+    int maxComponents = std::get<1>(GetParam());
+
+    Mat data(samples, dims, CV_32F), batch(samples, dims, CV_32F);
+    declare.in(data, batch, WARMUP_RNG);
+
+    PCA pca0(data, noArray(), PCA::DATA_AS_ROW, maxComponents), pca;
+    TEST_CYCLE()
+    {
+        pca = pca0;
+        pca.update(batch);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
@@ -0,0 +1,67 @@
+#include "perf_precomp.hpp"
+
+namespace opencv_test { namespace {
+using namespace perf;
+
+typedef tuple<Size, MatType> Size_MatType_t;
+typedef perf::TestBaseWithParam<Size_MatType_t> Size_MatType;
+
+PERF_TEST_P(Size_MatType, randu,
+            testing::Combine(
+                testing::Values(szVGA, sz1080p, Size(4096, 4096)),
+                testing::Values(CV_8UC1, CV_8UC3, CV_32FC1, CV_64FC1)
+                )
+            )
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    Mat dst(sz, type);
+    RNG rng(12345);
+
+    declare.out(dst);
+
+    TEST_CYCLE() rng.fill(dst, RNG::UNIFORM, 0, 100);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(Size_MatType, randn,
+            testing::Combine(
+                testing::Values(szVGA, sz1080p, Size(4096, 4096)),
+                testing::Values(CV_8UC1, CV_32FC1, CV_32FC3, CV_64FC1)
+                )
+            )
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    Mat dst(sz, type);
+    RNG rng(12345);
+
+    declare.out(dst);
+
+    TEST_CYCLE() rng.fill(dst, RNG::NORMAL, 100, 10);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(Size_MatType, randShuffle,
+            testing::Combine(
+                testing::Values(szVGA, sz1080p),
+                testing::Values(CV_8UC1, CV_32SC1)
+                )
+            )
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    Mat dst(sz, type);
+    randu(dst, 0, 100);
+    RNG rng(12345);
+
+    declare.in(dst);
+
+    TEST_CYCLE() randShuffle(dst, 1, &rng);
+
+    SANITY_CHECK_NOTHING();
+}
+
+}} // namespace
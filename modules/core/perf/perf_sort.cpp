@@ -47,4 +47,24 @@ PERF_TEST_P(sortIdxFixture, sorIdx, TYPICAL_MATS_SORT)
     SANITY_CHECK_NOTHING();
 }
 
+typedef sortFixture topKFixture;
+
+PERF_TEST_P(topKFixture, topK, testing::Combine(
+                testing::Values(Size(1000000, 1), Size(4096, 256)),
+                testing::Values(CV_8UC1, CV_32SC1, CV_32FC1),
+                testing::Values(10, 100)))
+{
+    const sortParams params = GetParam();
+    const Size sz = get<0>(params);
+    const int type = get<1>(params), k = get<2>(params);
+
+    cv::Mat a(sz, type), values, indices;
+
+    declare.in(a, WARMUP_RNG);
+
+    TEST_CYCLE() cv::topK(a, values, indices, k, SORT_EVERY_ROW | SORT_DESCENDING);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
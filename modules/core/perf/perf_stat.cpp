@@ -117,4 +117,38 @@ PERF_TEST_P(Size_MatType, hasNonZero, testing::Combine( testing::Values( TYPICAL
     SANITY_CHECK_NOTHING();
 }
 
+enum { STAT_SUM, STAT_MEAN_STD_DEV, STAT_MIN_MAX_LOC, STAT_NORM_L2, STAT_COUNT_NON_ZERO };
+CV_ENUM(StatFunc, STAT_SUM, STAT_MEAN_STD_DEV, STAT_MIN_MAX_LOC, STAT_NORM_L2, STAT_COUNT_NON_ZERO)
+
+typedef tuple<StatFunc, MatType> StatFunc_MatType_t;
+typedef perf::TestBaseWithParam<StatFunc_MatType_t> StatFunc_MatType;
+
+PERF_TEST_P(StatFunc_MatType, stat_large, testing::Combine(
+                StatFunc::all(), testing::Values(CV_8UC1, CV_32FC1)))
+{
+    int func = get<0>(GetParam()), matType = get<1>(GetParam());
+
+    Mat src(Size(3840, 2160), matType);
+    declare.in(src, WARMUP_RNG);
+
+    Scalar s, sdv;
+    double minVal = 0, maxVal = 0;
+    Point minLoc, maxLoc;
+    TEST_CYCLE()
+    {
+        if (func == STAT_SUM)
+            s = sum(src);
+        else if (func == STAT_MEAN_STD_DEV)
+            meanStdDev(src, s, sdv);
+        else if (func == STAT_MIN_MAX_LOC)
+            minMaxLoc(src, &minVal, &maxVal, &minLoc, &maxLoc);
+        else if (func == STAT_NORM_L2)
+            s[0] = cv::norm(src, NORM_L2);
+        else
+            s[0] = countNonZero(src);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
@@ -63,7 +63,17 @@
 
 #ifdef OPENCV_ALLOC_ENABLE_STATISTICS
 #define OPENCV_ALLOC_STATISTICS_LIMIT 4096  // don't track buffers less than N bytes
-#include <map>
+#endif
+
+#include <list>
+#include "opencv2/core/utils/arena_allocator.hpp"
+#include "opencv2/core/bufferpool.hpp"
+
+#if defined __linux__ && defined HAVE_POSIX_MEMALIGN
+#include <sys/mman.h>
+#if defined MADV_HUGEPAGE
+#define CV_HAVE_MADV_HUGEPAGE 1
+#endif
 #endif
 
 namespace cv {
@@ -235,6 +245,299 @@ void fastFree(void* ptr)
 
 #endif // OPENCV_ALLOC_ENABLE_STATISTICS
 
+namespace utils {
+
+ArenaMatAllocator::Params::Params()
+    : maxReservedSize((size_t)256 << 20),
+      prefault(false),
+      hugePages(false)
+{
+    // nothing
+}
+
+namespace {
+
+// Size-bucketed pool of CPU buffers, reserved (released) buffers are kept in LRU order
+class MatBufferPool CV_FINAL : public BufferPoolController
+{
+public:
+    struct BufferEntry
+    {
+        uchar* ptr;
+        size_t capacity;
+    };
+
+    MatBufferPool(const ArenaMatAllocator::Params& params)
+        : prefault(params.prefault),
+          hugePages(params.hugePages),
+          currentReservedSize(0),
+          maxReservedSize(params.maxReservedSize)
+    {
+        // nothing
+    }
+    virtual ~MatBufferPool()
+    {
+        freeAllReservedBuffers();
+        CV_Assert(reservedEntries_.empty());
+    }
+
+    // 4 size classes per power of two: up to 25% of memory overhead
+    static size_t getSizeClass(size_t size)
+    {
+        if (size <= 4096)
+            return alignSize(std::max(size, (size_t)1), 64);
+        size_t p = 4096;
+        while (p * 2 <= size)
+            p *= 2;
+        return alignSize(size, p / 4);
+    }
+
+    uchar* allocate(size_t size)
+    {
+        const size_t capacity = getSizeClass(size);
+        {
+            AutoLock locker(mutex_);
+            if (maxReservedSize > 0)
+            {
+                // most recently released buffers first
+                for (std::list<BufferEntry>::iterator i = reservedEntries_.begin(); i != reservedEntries_.end(); ++i)
+                {
+                    if (i->capacity == capacity)
+                    {
+                        uchar* ptr = i->ptr;
+                        reservedEntries_.erase(i);
+                        currentReservedSize -= capacity;
+                        stats.onPoolHit();
+                        stats.onAllocate(capacity);
+                        return ptr;
+                    }
+                }
+            }
+        }
+        uchar* ptr = _allocateBuffer(capacity);
+        stats.onPoolMiss();
+        stats.onAllocate(capacity);
+        return ptr;
+    }
+
+    void release(uchar* ptr, size_t size)
+    {
+        const size_t capacity = getSizeClass(size);
+        stats.onFree(capacity);
+        {
+            AutoLock locker(mutex_);
+            if (maxReservedSize > 0 && capacity <= maxReservedSize / 8)
+            {
+                BufferEntry entry = { ptr, capacity };
+                reservedEntries_.push_front(entry);
+                currentReservedSize += capacity;
+                _checkSizeOfReservedEntries();
+                return;
+            }
+        }
+        _releaseBuffer(ptr, capacity);
+    }
+
+    virtual size_t getReservedSize() const CV_OVERRIDE { return currentReservedSize; }
+    virtual size_t getMaxReservedSize() const CV_OVERRIDE { return maxReservedSize; }
+    virtual void setMaxReservedSize(size_t size) CV_OVERRIDE
+    {
+        AutoLock locker(mutex_);
+        size_t oldMaxReservedSize = maxReservedSize;
+        maxReservedSize = size;
+        if (maxReservedSize < oldMaxReservedSize)
+        {
+            std::list<BufferEntry>::iterator i = reservedEntries_.begin();
+            for (; i != reservedEntries_.end();)
+            {
+                if (i->capacity > maxReservedSize / 8)
+                {
+                    currentReservedSize -= i->capacity;
+                    _releaseBuffer(i->ptr, i->capacity);
+                    i = reservedEntries_.erase(i);
+                    continue;
+                }
+                ++i;
+            }
+            _checkSizeOfReservedEntries();
+        }
+    }
+    virtual void freeAllReservedBuffers() CV_OVERRIDE
+    {
+        AutoLock locker(mutex_);
+        for (std::list<BufferEntry>::const_iterator i = reservedEntries_.begin(); i != reservedEntries_.end(); ++i)
+            _releaseBuffer(i->ptr, i->capacity);
+        reservedEntries_.clear();
+        currentReservedSize = 0;
+    }
+
+    utils::AllocatorStatistics stats;
+
+protected:
+    // synchronized
+    void _checkSizeOfReservedEntries()
+    {
+        while (currentReservedSize > maxReservedSize)
+        {
+            CV_DbgAssert(!reservedEntries_.empty());
+            const BufferEntry& entry = reservedEntries_.back();
+            CV_DbgAssert(currentReservedSize >= entry.capacity);
+            currentReservedSize -= entry.capacity;
+            _releaseBuffer(entry.ptr, entry.capacity);
+            reservedEntries_.pop_back();
+        }
+    }
+
+    bool _isHugePageBuffer(size_t capacity) const
+    {
+#ifdef CV_HAVE_MADV_HUGEPAGE
+        return hugePages && capacity >= ((size_t)2 << 20);
+#else
+        CV_UNUSED(capacity);
+        return false;
+#endif
+    }
+
+    uchar* _allocateBuffer(size_t capacity)
+    {
+        uchar* ptr = NULL;
+#ifdef CV_HAVE_MADV_HUGEPAGE
+        if (_isHugePageBuffer(capacity))
+        {
+            void* p = NULL;
+            if (posix_memalign(&p, (size_t)2 << 20, capacity) != 0 || !p)
+                OutOfMemoryError(capacity);
+            (void)madvise(p, capacity, MADV_HUGEPAGE);  // hint, errors are not critical
+            ptr = (uchar*)p;
+        }
+        else
+#endif
+        {
+            ptr = (uchar*)fastMalloc(capacity);
+        }
+        if (prefault)
+        {
+            for (size_t ofs = 0; ofs < capacity; ofs += 4096)
+                ptr[ofs] = 0;
+        }
+        return ptr;
+    }
+
+    void _releaseBuffer(uchar* ptr, size_t capacity)
+    {
+        if (_isHugePageBuffer(capacity))
+            free(ptr);
+        else
+            fastFree(ptr);
+    }
+
+    const bool prefault;
+    const bool hugePages;
+
+    Mutex mutex_;
+    size_t currentReservedSize;
+    size_t maxReservedSize;
+    std::list<BufferEntry> reservedEntries_; // LRU order. Allocated, but not used entries
+};
+
+class ArenaMatAllocatorImpl CV_FINAL : public ArenaMatAllocator
+{
+public:
+    ArenaMatAllocatorImpl(const Params& params)
+        : pool(params)
+    {
+        // nothing
+    }
+
+    UMatData* allocate(int dims, const int* sizes, int type,
+                       void* data0, size_t* step, AccessFlag /*flags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        size_t total = CV_ELEM_SIZE(type);
+        for( int i = dims-1; i >= 0; i-- )
+        {
+            if( step )
+            {
+                if( data0 && step[i] != CV_AUTOSTEP )
+                {
+                    CV_Assert(total <= step[i]);
+                    total = step[i];
+                }
+                else
+                    step[i] = total;
+            }
+            total *= sizes[i];
+        }
+        uchar* data = data0 ? (uchar*)data0 : pool.allocate(total);
+        UMatData* u = new UMatData(this);
+        u->data = u->origdata = data;
+        u->size = total;
+        if(data0)
+            u->flags |= UMatData::USER_ALLOCATED;
+
+        return u;
+    }
+
+    bool allocate(UMatData* u, AccessFlag /*accessFlags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        if(!u) return false;
+        return true;
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if(!u)
+            return;
+
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        if( !(u->flags & UMatData::USER_ALLOCATED) )
+        {
+            pool.release(u->origdata, u->size);
+            u->origdata = 0;
+        }
+        delete u;
+    }
+
+    BufferPoolController* getBufferPoolController(const char* id) const CV_OVERRIDE
+    {
+        if (id != NULL && strcmp(id, "CPU") != 0)
+        {
+            CV_Error(cv::Error::StsBadArg, "getBufferPoolController(): unknown BufferPool ID\n");
+        }
+        return &pool;
+    }
+
+    const AllocatorStatisticsInterface& getStatistics() const CV_OVERRIDE { return pool.stats; }
+
+    size_t getReservedSize() const CV_OVERRIDE { return pool.getReservedSize(); }
+
+    void freeAllReservedBuffers() CV_OVERRIDE { pool.freeAllReservedBuffers(); }
+
+protected:
+    mutable MatBufferPool pool;
+};
+
+} // namespace
+
+Ptr<ArenaMatAllocator> ArenaMatAllocator::create(const Params& params)
+{
+    return makePtr<ArenaMatAllocatorImpl>(params);
+}
+
+} // namespace utils
+
+static MatAllocator* createBufferPoolAllocator()
+{
+    utils::ArenaMatAllocator::Params params;
+    params.maxReservedSize = utils::getConfigurationParameterSizeT("OPENCV_CPU_BUFFERPOOL_LIMIT", params.maxReservedSize);
+    return new utils::ArenaMatAllocatorImpl(params);
+}
+
+MatAllocator* Mat::getBufferPoolAllocator()
+{
+    CV_SINGLETON_LAZY_INIT(MatAllocator, createBufferPoolAllocator())
+}
+
 } // namespace
 
 CV_IMPL void* cvAlloc( size_t size )
@@ -116,6 +116,22 @@ static bool ipp_countNonZero( Mat &src, int &res )
 }
 #endif
 
+static int countNonZero_(const Mat& src)
+{
+    CountNonZeroFunc func = getCountNonZeroTab(src.depth());
+    CV_Assert( func != 0 );
+
+    const Mat* arrays[] = {&src, 0};
+    uchar* ptrs[1] = {};
+    NAryMatIterator it(arrays, ptrs);
+    int total = (int)it.size, nz = 0;
+
+    for( size_t i = 0; i < it.nplanes; i++, ++it )
+        nz += func( ptrs[0], total );
+
+    return nz;
+}
+
 int countNonZero(InputArray _src)
 {
     CV_INSTRUMENT_REGION();
@@ -136,18 +152,13 @@ int countNonZero(InputArray _src)
     Mat src = _src.getMat();
     CV_IPP_RUN_FAST(ipp_countNonZero(src, res), res);
 
-    CountNonZeroFunc func = getCountNonZeroTab(src.depth());
-    CV_Assert( func != 0 );
-
+    int nz = 0;
     const Mat* arrays[] = {&src, 0};
-    uchar* ptrs[1] = {};
-    NAryMatIterator it(arrays, ptrs);
-    int total = (int)it.size, nz = 0;
-
-    for( size_t i = 0; i < it.nplanes; i++, ++it )
-        nz += func( ptrs[0], total );
-
-    return nz;
+    if( parallelReduce(arrays, nz,
+                       [](const Mat* chunks, size_t) { return countNonZero_(chunks[0]); },
+                       [](int& a, int b) { a += b; }) )
+        return nz;
+    return countNonZero_(src);
 }
 
 void findNonZero(InputArray _src, OutputArray _idx)
@@ -43,7 +43,9 @@
 #include "opencv2/core/opencl/runtime/opencl_clfft.hpp"
 #include "opencv2/core/opencl/runtime/opencl_core.hpp"
 #include "opencl_kernels_core.hpp"
+#include "opencv2/core/utils/configuration.private.hpp"
 #include <map>
+#include <list>
 
 namespace cv
 {
@@ -1189,6 +1191,72 @@ DFT(const OcvDftOptions & c, const Complex<T>* src, Complex<T>* dst)
    output vector format:
      re(0), re(1), im(1), ... , re(n/2-1), im((n+1)/2-1) [, re((n+1)/2)] OR ...
      re(0), 0, re(1), im(1), ..., re(n/2-1), im((n+1)/2-1) [, re((n+1)/2), 0] */
+/* Post-processing of the packed real FFT (see RealDFT): k-th and (n/2-k)-th outputs
+   are computed from k-th and (n/2-k)-th elements of the half-length complex FFT.
+   Returns the first k that is not processed. */
+template<typename T> struct RealDFT_VecPost
+{
+    int operator()(T*, int, const Complex<T>*, T, T&) const { return 1; }
+};
+
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+template<typename T, typename VT> static int
+RealDFTPost_SIMD(T* dst, int n, const Complex<T>* wave, const VT& v_scale2, T& t)
+{
+    const int L = VTraits<VT>::vlanes();
+    int n2 = n >> 1, k = 1;
+    if( 2*(k + L - 1) >= n2 )
+        return k;
+
+    // mirrored elements n/2-k-L+1 ... n/2-k
+    VT b_re, b_im;
+    v_load_deinterleave(dst + n - 2*(k + L - 1), b_re, b_im);
+
+    for( ; 2*(k + L - 1) < n2; k += L )
+    {
+        VT a_re, a_im, w_re, w_im;
+        v_load_deinterleave(dst + 2*k, a_re, a_im);
+        v_load_deinterleave((const T*)(wave + k), w_re, w_im);
+        VT c_re = v_reverse(b_re), c_im = v_reverse(b_im);
+
+        // the output is shifted by one value, so it overwrites the last value of the next
+        // mirrored block: load the block in advance
+        t = dst[n - 2*(k + L) + 1];
+        if( 2*(k + 2*L - 1) < n2 )
+            v_load_deinterleave(dst + n - 2*(k + 2*L - 1), b_re, b_im);
+
+        VT h1_re = v_mul(v_add(a_re, c_re), v_scale2), h1_im = v_mul(v_sub(a_im, c_im), v_scale2);
+        VT h2_re = v_mul(v_add(a_im, c_im), v_scale2), h2_im = v_mul(v_sub(c_re, a_re), v_scale2);
+        VT r_re = v_sub(v_mul(h2_re, w_re), v_mul(h2_im, w_im));
+        VT r_im = v_add(v_mul(h2_re, w_im), v_mul(h2_im, w_re));
+
+        v_store_interleave(dst + 2*k - 1, v_add(h1_re, r_re), v_add(h1_im, r_im));
+        v_store_interleave(dst + n - 2*(k + L - 1) - 1,
+                           v_reverse(v_sub(h1_re, r_re)), v_reverse(v_sub(r_im, h1_im)));
+    }
+    vx_cleanup();
+    return k;
+}
+
+template<> struct RealDFT_VecPost<float>
+{
+    int operator()(float* dst, int n, const Complexf* wave, float scale2, float& t) const
+    {
+        return RealDFTPost_SIMD(dst, n, wave, vx_setall_f32(scale2), t);
+    }
+};
+#endif
+
+#if (CV_SIMD_64F || CV_SIMD_SCALABLE_64F)
+template<> struct RealDFT_VecPost<double>
+{
+    int operator()(double* dst, int n, const Complexd* wave, double scale2, double& t) const
+    {
+        return RealDFTPost_SIMD(dst, n, wave, vx_setall_f64(scale2), t);
+    }
+};
+#endif
+
 template<typename T> static void
 RealDFT(const OcvDftOptions & c, const T* src, T* dst)
 {
@@ -1280,11 +1348,13 @@ RealDFT(const OcvDftOptions & c, const T* src, T* dst)
 
         t0 = dst[n2];
         t = dst[n-1];
-        dst[n-1] = dst[1];
+        T last = dst[1];
 
         const Complex<T> *wave = (const Complex<T>*)c.wave;
+        int k = RealDFT_VecPost<T>()(dst, n, wave, scale2, t);
+        dst[n-1] = last;
 
-        for( j = 2, wave++; j < n2; j += 2, wave++ )
+        for( j = k*2, wave += k; j < n2; j += 2, wave++ )
         {
             /* calc odd */
             h2_re = scale2*(dst[j+1] + t);
@@ -3540,6 +3610,260 @@ void cv::idft( InputArray src, OutputArray dst, int flags, int nonzero_rows )
     dft( src, dst, flags | DFT_INVERSE, nonzero_rows );
 }
 
+namespace cv {
+
+DFTPlan::~DFTPlan() {}
+
+namespace {
+
+class DFTPlanImpl CV_FINAL : public DFTPlan
+{
+public:
+    DFTPlanImpl(Size _size, int _type, int _flags, int _nonzeroRows)
+        : size_(_size), type_(_type), flags_(_flags), nonzeroRows_(_nonzeroRows)
+    {
+        int depth = CV_MAT_DEPTH(type_), cn = CV_MAT_CN(type_);
+        bool inv = (flags_ & DFT_INVERSE) != 0;
+
+        CV_Assert( type_ == CV_32FC1 || type_ == CV_32FC2 || type_ == CV_64FC1 || type_ == CV_64FC2 );
+        CV_Assert( !((flags_ & DFT_COMPLEX_INPUT) && cn != 2) );
+        CV_Assert( size_.width > 0 && size_.height > 0 );
+
+        if( !inv && cn == 1 && (flags_ & DFT_COMPLEX_OUTPUT) )
+            dstType_ = CV_MAKETYPE(depth, 2);
+        else if( inv && cn == 2 && (flags_ & DFT_REAL_OUTPUT) )
+            dstType_ = depth;
+        else
+            dstType_ = type_;
+
+        halFlags_ = 0;
+        if (inv)
+            halFlags_ |= CV_HAL_DFT_INVERSE;
+        if (flags_ & DFT_ROWS)
+            halFlags_ |= CV_HAL_DFT_ROWS;
+        if (flags_ & DFT_SCALE)
+            halFlags_ |= CV_HAL_DFT_SCALE;
+
+        // the most common variant (continuous arrays, separate output) is prepared in advance
+        pools_[CONTINUOUS].push_back(createContext(CONTINUOUS));
+    }
+
+    void execute(InputArray _src, OutputArray _dst) const CV_OVERRIDE
+    {
+        CV_INSTRUMENT_REGION();
+
+        Mat src = _src.getMat();
+        CV_Assert( src.dims <= 2 && src.size() == size_ && src.type() == type_ );
+        _dst.create(size_, dstType_);
+        Mat dst = _dst.getMat();
+        apply(src, dst);
+    }
+
+    void executeBatch(InputArrayOfArrays _src, OutputArrayOfArrays _dst) const CV_OVERRIDE
+    {
+        CV_INSTRUMENT_REGION();
+
+        std::vector<Mat> src, dst;
+        if (_src.isMat() || _src.isUMat() || _src.isMatx())
+        {
+            // 3D array: count x rows x cols, the output is a 3D array of the same layout
+            Mat src3d = _src.getMat();
+            CV_Assert( src3d.dims == 3 && src3d.size[1] == size_.height && src3d.size[2] == size_.width &&
+                       src3d.type() == type_ );
+            CV_Assert( _dst.isMat() || _dst.isUMat() );
+            _dst.create(3, src3d.size.p, dstType_);
+            Mat dst3d = _dst.getMat();
+            int count = src3d.size[0];
+            src.resize(count);
+            dst.resize(count);
+            for (int i = 0; i < count; i++)
+            {
+                src[i] = Mat(size_, type_, src3d.ptr(i), src3d.step[1]);
+                dst[i] = Mat(size_, dstType_, dst3d.ptr(i), dst3d.step[1]);
+            }
+        }
+        else
+        {
+            _src.getMatVector(src);
+            int count = (int)src.size();
+            for (int i = 0; i < count; i++)
+                CV_Assert( src[i].dims <= 2 && src[i].size() == size_ && src[i].type() == type_ );
+
+            _dst.create(count, 1, dstType_, -1, true);
+            dst.resize(count);
+            for (int i = 0; i < count; i++)
+            {
+                _dst.create(size_, dstType_, i, true);
+                dst[i] = _dst.getMat(i);
+            }
+        }
+
+        // the batch is split between threads by whole arrays
+        parallel_for_(Range(0, (int)src.size()), [&](const Range& r)
+        {
+            for (int i = r.start; i < r.end; i++)
+                apply(src[i], dst[i]);
+        });
+    }
+
+    Size size() const CV_OVERRIDE { return size_; }
+    int type() const CV_OVERRIDE { return type_; }
+    int dstType() const CV_OVERRIDE { return dstType_; }
+    int flags() const CV_OVERRIDE { return flags_; }
+
+protected:
+    // hal contexts depend on the layout of arrays, each of the variants has own pool of contexts
+    enum { CONTINUOUS = 1, INPLACE = 2, VARIANTS = 4 };
+
+    Ptr<hal::DFT2D> createContext(int variant) const
+    {
+        int f = halFlags_;
+        if (variant & CONTINUOUS)
+            f |= CV_HAL_DFT_IS_CONTINUOUS;
+        if (variant & INPLACE)
+            f |= CV_HAL_DFT_IS_INPLACE;
+        return hal::DFT2D::create(size_.width, size_.height, CV_MAT_DEPTH(type_),
+                                  CV_MAT_CN(type_), CV_MAT_CN(dstType_), f, nonzeroRows_);
+    }
+
+    // contexts keep work buffers, so each of concurrent calls takes own context from the pool
+    void apply(const Mat& src, Mat& dst) const
+    {
+        int variant = (src.isContinuous() && dst.isContinuous() ? CONTINUOUS : 0) |
+                      (src.data == dst.data ? INPLACE : 0);
+        Ptr<hal::DFT2D> c;
+        {
+            AutoLock lock(mutex_);
+            std::vector<Ptr<hal::DFT2D> >& pool = pools_[variant];
+            if (!pool.empty())
+            {
+                c = pool.back();
+                pool.pop_back();
+            }
+        }
+        if (!c)
+            c = createContext(variant);
+
+        c->apply(src.data, src.step, dst.data, dst.step);
+
+        AutoLock lock(mutex_);
+        pools_[variant].push_back(c);
+    }
+
+    Size size_;
+    int type_;
+    int dstType_;
+    int flags_;
+    int nonzeroRows_;
+    int halFlags_;
+
+    mutable Mutex mutex_;
+    mutable std::vector<Ptr<hal::DFT2D> > pools_[VARIANTS];
+};
+
+struct DFTPlanCache
+{
+    struct Key
+    {
+        Size size;
+        int type, flags, nonzeroRows;
+
+        bool operator==(const Key& k) const
+        {
+            return size == k.size && type == k.type && flags == k.flags && nonzeroRows == k.nonzeroRows;
+        }
+    };
+
+    DFTPlanCache()
+    {
+        maxSize = utils::getConfigurationParameterSizeT("OPENCV_DFT_PLAN_CACHE_SIZE", 16);
+    }
+
+    Ptr<DFTPlan> get(const Key& key)
+    {
+        AutoLock lock(mutex);
+        for (std::list<std::pair<Key, Ptr<DFTPlan> > >::iterator it = plans.begin(); it != plans.end(); ++it)
+        {
+            if (it->first == key)
+            {
+                plans.splice(plans.begin(), plans, it);  // the most recently used plans are in front
+                return it->second;
+            }
+        }
+        return Ptr<DFTPlan>();
+    }
+
+    void put(const Key& key, const Ptr<DFTPlan>& plan)
+    {
+        AutoLock lock(mutex);
+        plans.push_front(std::make_pair(key, plan));
+        while (plans.size() > maxSize)
+            plans.pop_back();
+    }
+
+    size_t maxSize;
+    Mutex mutex;
+    std::list<std::pair<Key, Ptr<DFTPlan> > > plans;
+};
+
+static DFTPlanCache& getDFTPlanCache()
+{
+    CV_SINGLETON_LAZY_INIT_REF(DFTPlanCache, new DFTPlanCache())
+}
+
+} // namespace
+
+Ptr<DFTPlan> DFTPlan::create(Size size, int type, int flags, int nonzeroRows)
+{
+    CV_INSTRUMENT_REGION();
+
+    DFTPlanCache& cache = getDFTPlanCache();
+    if (cache.maxSize == 0)
+        return makePtr<DFTPlanImpl>(size, type, flags, nonzeroRows);
+
+    DFTPlanCache::Key key = { size, type, flags, nonzeroRows };
+    Ptr<DFTPlan> plan = cache.get(key);
+    if (!plan)
+    {
+        plan = makePtr<DFTPlanImpl>(size, type, flags, nonzeroRows);
+        cache.put(key, plan);
+    }
+    return plan;
+}
+
+void dftBatch(InputArrayOfArrays src, OutputArrayOfArrays dst, int flags, int nonzeroRows)
+{
+    CV_INSTRUMENT_REGION();
+
+    Size size;
+    int type;
+    if (src.isMat() || src.isUMat() || src.isMatx())
+    {
+        Mat m = src.getMat();
+        CV_Assert( m.dims == 3 );
+        size = Size(m.size[2], m.size[1]);
+        type = m.type();
+        if (m.size[0] == 0)
+        {
+            dst.release();
+            return;
+        }
+    }
+    else
+    {
+        if (src.empty())
+        {
+            dst.release();
+            return;
+        }
+        size = src.size(0);
+        type = src.type(0);
+    }
+    DFTPlan::create(size, type, flags, nonzeroRows)->executeBatch(src, dst);
+}
+
+} // namespace cv
+
 #ifdef HAVE_OPENCL
 
 namespace cv {
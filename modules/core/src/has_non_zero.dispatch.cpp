@@ -7,6 +7,8 @@
 #include "opencl_kernels_core.hpp"
 #include "stat.hpp"
 
+#include <atomic>
+
 #include "has_non_zero.simd.hpp"
 #include "has_non_zero.simd_declarations.hpp" // defines CV_CPU_DISPATCH_MODES_ALL=AVX2,...,BASELINE based on CMakeLists.txt content
 
@@ -57,23 +59,9 @@ static bool ocl_hasNonZero( InputArray _src, bool & res )
 }
 #endif
 
-bool hasNonZero(InputArray _src)
+static bool hasNonZero_(const Mat& src)
 {
-    CV_INSTRUMENT_REGION();
-
-    int type = _src.type(), cn = CV_MAT_CN(type);
-    CV_Assert( cn == 1 );
-
     bool res = false;
-
-#ifdef HAVE_OPENCL
-    CV_OCL_RUN_(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2,
-                ocl_hasNonZero(_src, res),
-                res)
-#endif
-
-    Mat src = _src.getMat();
-
     HasNonZeroFunc func = getHasNonZeroTab(src.depth());
     CV_Assert( func != 0 );
 
@@ -104,4 +92,37 @@ bool hasNonZero(InputArray _src)
     return res;
 }
 
+bool hasNonZero(InputArray _src)
+{
+    CV_INSTRUMENT_REGION();
+
+    int type = _src.type(), cn = CV_MAT_CN(type);
+    CV_Assert( cn == 1 );
+
+#ifdef HAVE_OPENCL
+    bool res = false;
+    CV_OCL_RUN_(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2,
+                ocl_hasNonZero(_src, res),
+                res)
+#endif
+
+    Mat src = _src.getMat();
+
+    // the remaining chunks are skipped once a non-zero element is found
+    std::atomic<bool> found(false);
+    int nz = 0;
+    const Mat* arrays[] = {&src, 0};
+    if( parallelReduce(arrays, nz,
+                       [&found](const Mat* chunks, size_t)
+                       {
+                           if( found.load(std::memory_order_relaxed) || !hasNonZero_(chunks[0]) )
+                               return 0;
+                           found.store(true, std::memory_order_relaxed);
+                           return 1;
+                       },
+                       [](int& a, int b) { a |= b; }) )
+        return nz != 0;
+    return hasNonZero_(src);
+}
+
 } // namespace
@@ -51,6 +51,7 @@ namespace cv
 {
 
 static int CV_KMEANS_PARALLEL_GRANULARITY = (int)utils::getConfigurationParameterSizeT("OPENCV_KMEANS_PARALLEL_GRANULARITY", 1000);
+static int CV_KMEANS_MINI_BATCH_SIZE = (int)utils::getConfigurationParameterSizeT("OPENCV_KMEANS_MINI_BATCH_SIZE", 1024);
 
 static void generateRandomCenter(int dims, const Vec2f* box, float* center, RNG& rng)
 {
@@ -223,6 +224,242 @@ private:
     const Mat& centers;
 };
 
+/*
+Assignment step of the algorithm by G. Hamerly (2010) Making k-means even faster.
+For each sample an upper bound of the distance to its center and a lower bound of the distance
+to the second closest center are kept. After the centers move by shifts[k], the sample can't change
+its center if the upper bound doesn't exceed the lower bound or half of the distance from its center
+to the closest other center (halfDist[k]).
+*/
+class KMeansBoundedDistanceComputer : public ParallelLoopBody
+{
+public:
+    KMeansBoundedDistanceComputer( int *labels_,
+                                   double *upper_,
+                                   double *lower_,
+                                   const Mat& data_,
+                                   const Mat& centers_,
+                                   const double *shifts_,
+                                   const double *halfDist_)
+        : labels(labels_),
+          upper(upper_),
+          lower(lower_),
+          data(data_),
+          centers(centers_),
+          shifts(shifts_),
+          halfDist(halfDist_),
+          maxShiftIdx(-1),
+          maxShift(0),
+          secondMaxShift(0)
+    {
+        // the lower bound is decreased by the largest shift of other centers
+        for (int k = 0; shifts && k < centers.rows; k++)
+        {
+            if (shifts[k] > maxShift)
+            {
+                secondMaxShift = maxShift;
+                maxShift = shifts[k];
+                maxShiftIdx = k;
+            }
+            else
+                secondMaxShift = std::max(secondMaxShift, shifts[k]);
+        }
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        const int begin = range.start;
+        const int end = range.end;
+        const int K = centers.rows;
+        const int dims = centers.cols;
+
+        for (int i = begin; i < end; ++i)
+        {
+            const float *sample = data.ptr<float>(i);
+            if (shifts)
+            {
+                int l = labels[i];
+                double u = upper[i] + shifts[l];
+                double lo = lower[i] - (l == maxShiftIdx ? secondMaxShift : maxShift);
+                double m = std::max(halfDist[l], lo);
+                if (u > m)
+                    u = std::sqrt((double)hal::normL2Sqr_(sample, centers.ptr<float>(l), dims));
+                if (u <= m)
+                {
+                    upper[i] = u;
+                    lower[i] = lo;
+                    continue;
+                }
+            }
+
+            int k_best = 0;
+            double min_dist = DBL_MAX, min_dist2 = DBL_MAX;
+
+            for (int k = 0; k < K; k++)
+            {
+                const float* center = centers.ptr<float>(k);
+                const double dist = hal::normL2Sqr_(sample, center, dims);
+
+                if (min_dist > dist)
+                {
+                    min_dist2 = min_dist;
+                    min_dist = dist;
+                    k_best = k;
+                }
+                else if (min_dist2 > dist)
+                    min_dist2 = dist;
+            }
+
+            labels[i] = k_best;
+            upper[i] = std::sqrt(min_dist);
+            lower[i] = std::sqrt(min_dist2);
+        }
+    }
+
+private:
+    KMeansBoundedDistanceComputer& operator=(const KMeansBoundedDistanceComputer&); // = delete
+
+    int *labels;
+    double *upper;
+    double *lower;
+    const Mat& data;
+    const Mat& centers;
+    const double *shifts;
+    const double *halfDist;
+    int maxShiftIdx;
+    double maxShift;
+    double secondMaxShift;
+};
+
+// half of the distance from each center to the closest other center
+static void computeHalfCenterDistances(const Mat& centers, double* halfDist)
+{
+    const int K = centers.rows, dims = centers.cols;
+    parallel_for_(Range(0, K), [&](const Range& range)
+    {
+        for (int k = range.start; k < range.end; k++)
+        {
+            double min_dist = DBL_MAX;
+            for (int k1 = 0; k1 < K; k1++)
+            {
+                if (k1 != k)
+                    min_dist = std::min(min_dist, (double)hal::normL2Sqr_(centers.ptr<float>(k), centers.ptr<float>(k1), dims));
+            }
+            halfDist[k] = 0.5*std::sqrt(min_dist);
+        }
+    }, (double)divUp((size_t)(dims * K * K), CV_KMEANS_PARALLEL_GRANULARITY));
+}
+
+/*
+Mini-batch k-means, D. Sculley (2010) Web-scale k-means clustering.
+The centers are updated by small random subsets of samples with per-center learning rate,
+then all samples are assigned to the closest centers. Returns the compactness.
+*/
+static double kmeansMiniBatch(const Mat& data, int K, int* labels, double* dists, Mat& centers,
+                              const TermCriteria& criteria, int iterations, bool useInitialLabels,
+                              int flags, int ppTrials, const Vec2f* box, RNG& rng)
+{
+    CV_TRACE_FUNCTION();
+    const int N = data.rows, dims = data.cols;
+    const int B = std::min(std::max(CV_KMEANS_MINI_BATCH_SIZE, 1), N);
+
+    if (useInitialLabels)
+    {
+        cv::AutoBuffer<int, 64> counters(K);
+        centers = Scalar(0);
+        for (int k = 0; k < K; k++)
+            counters[k] = 0;
+        for (int i = 0; i < N; i++)
+        {
+            const float* sample = data.ptr<float>(i);
+            float* center = centers.ptr<float>(labels[i]);
+            for (int j = 0; j < dims; j++)
+                center[j] += sample[j];
+            counters[labels[i]]++;
+        }
+        for (int k = 0; k < K; k++)
+        {
+            if (counters[k] == 0)
+                data.row(rng.uniform(0, N)).copyTo(centers.row(k));
+            else
+                centers.row(k) *= 1./counters[k];
+        }
+    }
+    else if (flags & KMEANS_PP_CENTERS)
+    {
+        // k-means++ on a random subset of samples
+        const int M = std::min(N, std::max(3*B, 3*K));
+        if (M == N)
+            generateCentersPP(data, centers, K, rng, ppTrials);
+        else
+        {
+            Mat subset(M, dims, CV_32F);
+            for (int i = 0; i < M; i++)
+                data.row(rng.uniform(0, N)).copyTo(subset.row(i));
+            generateCentersPP(subset, centers, K, rng, ppTrials);
+        }
+    }
+    else
+    {
+        for (int k = 0; k < K; k++)
+            generateRandomCenter(dims, box, centers.ptr<float>(k), rng);
+    }
+
+    cv::AutoBuffer<int, 64> batch(B), batchLabels(B);
+    cv::AutoBuffer<double, 64> counts(K);
+    for (int k = 0; k < K; k++)
+        counts[k] = 0;
+    Mat old_centers;
+
+    for (int iter = 0; iter < iterations; iter++)
+    {
+        for (int b = 0; b < B; b++)
+            batch[b] = rng.uniform(0, N);
+
+        parallel_for_(Range(0, B), [&](const Range& range)
+        {
+            for (int b = range.start; b < range.end; b++)
+            {
+                const float* sample = data.ptr<float>(batch[b]);
+                int k_best = 0;
+                float min_dist = FLT_MAX;
+                for (int k = 0; k < K; k++)
+                {
+                    float dist = hal::normL2Sqr_(sample, centers.ptr<float>(k), dims);
+                    if (min_dist > dist)
+                    {
+                        min_dist = dist;
+                        k_best = k;
+                    }
+                }
+                batchLabels[b] = k_best;
+            }
+        }, (double)divUp((size_t)(dims * B * K), CV_KMEANS_PARALLEL_GRANULARITY));
+
+        centers.copyTo(old_centers);
+        for (int b = 0; b < B; b++)
+        {
+            const float* sample = data.ptr<float>(batch[b]);
+            int k = batchLabels[b];
+            float* center = centers.ptr<float>(k);
+            float eta = (float)(1./++counts[k]);
+            for (int j = 0; j < dims; j++)
+                center[j] += (sample[j] - center[j])*eta;
+        }
+
+        double max_center_shift = 0;
+        for (int k = 0; k < K; k++)
+            max_center_shift = std::max(max_center_shift,
+                (double)hal::normL2Sqr_(centers.ptr<float>(k), old_centers.ptr<float>(k), dims));
+        if (max_center_shift <= criteria.epsilon)
+            break;
+    }
+
+    parallel_for_(Range(0, N), KMeansDistanceComputer<false>(dists, labels, data, centers), (double)divUp((size_t)(dims * N * K), CV_KMEANS_PARALLEL_GRANULARITY));
+    return sum(Mat(Size(N, 1), CV_64F, dists))[0];
+}
+
 }
 
 double cv::kmeans( InputArray _data, int K,
@@ -284,6 +521,7 @@ double cv::kmeans( InputArray _data, int K,
         criteria.epsilon = FLT_EPSILON;
     criteria.epsilon *= criteria.epsilon;
 
+    const int miniBatchIterations = (criteria.type & TermCriteria::COUNT) ? std::max(criteria.maxCount, 1) : 100;
     if (criteria.type & TermCriteria::COUNT)
         criteria.maxCount = std::min(std::max(criteria.maxCount, 2), 100);
     else
@@ -315,12 +553,23 @@ double cv::kmeans( InputArray _data, int K,
         }
     }
 
+    const bool accelerated = (flags & KMEANS_ACCELERATED) != 0;
+    cv::AutoBuffer<double, 64> bounds(accelerated ? 2*N + 2*K : 0);
+    double *upper = bounds.data(), *lower = upper + N, *shifts = lower + N, *halfDist = shifts + K;
+
     double best_compactness = DBL_MAX;
     for (int a = 0; a < attempts; a++)
     {
         double compactness = 0;
 
-        for (int iter = 0; ;)
+        bool boundsValid = false;
+        if (flags & KMEANS_MINI_BATCH)
+        {
+            compactness = kmeansMiniBatch(data, K, labels, dists.data(), centers, criteria, miniBatchIterations,
+                                          a == 0 && (flags & KMEANS_USE_INITIAL_LABELS), flags, SPP_TRIALS,
+                                          box.data(), rng);
+        }
+        else for (int iter = 0; ;)
         {
             double max_center_shift = iter == 0 ? DBL_MAX : 0.0;
 
@@ -394,6 +643,12 @@ double cv::kmeans( InputArray _data, int K,
                     counters[max_k]--;
                     counters[k]++;
                     labels[farthest_i] = k;
+                    if (boundsValid)
+                    {
+                        // the bounds are not valid for the moved sample
+                        upper[farthest_i] = DBL_MAX;
+                        lower[farthest_i] = 0;
+                    }
 
                     const float* sample = data.ptr<float>(farthest_i);
                     float* cur_center = centers.ptr<float>(k);
@@ -423,6 +678,8 @@ double cv::kmeans( InputArray _data, int K,
                             dist += t*t;
                         }
                         max_center_shift = std::max(max_center_shift, dist);
+                        if (accelerated)
+                            shifts[k] = std::sqrt(dist);
                     }
                 }
             }
@@ -436,6 +693,16 @@ double cv::kmeans( InputArray _data, int K,
                 compactness = sum(Mat(Size(N, 1), CV_64F, &dists[0]))[0];
                 break;
             }
+            else if (accelerated)
+            {
+                // assign labels, the first assignment computes all distances to initialize the bounds
+                if (boundsValid)
+                    computeHalfCenterDistances(centers, halfDist);
+                parallel_for_(Range(0, N), KMeansBoundedDistanceComputer(labels, upper, lower, data, centers,
+                                                                         boundsValid ? shifts : NULL, halfDist),
+                              (double)divUp((size_t)(dims * N), CV_KMEANS_PARALLEL_GRANULARITY));
+                boundsValid = true;
+            }
             else
             {
                 // assign labels
@@ -42,6 +42,7 @@
 
 #include "precomp.hpp"
 #include <limits>
+#include <atomic>
 
 #ifdef HAVE_EIGEN
 #  if defined(_MSC_VER)
@@ -359,15 +360,74 @@ template<> inline int VBLAS<double>::givens(double* a, double* b, int n, double
 #endif //CV_SIMD_64F
 #endif //CV_SIMD
 
+// orthogonalizes the rows i and j of At by the Jacobi rotation, applies the same rotation to Vt
+template<typename _Tp> static inline bool
+JacobiSVDRotate(_Tp* At, size_t astep, double* W, _Tp* Vt, size_t vstep,
+                int m, int n, int i, int j, _Tp eps)
+{
+    VBLAS<_Tp> vblas;
+    _Tp *Ai = At + i*astep, *Aj = At + j*astep;
+    double a = W[i], p = 0, b = W[j];
+    _Tp c, s;
+    int k;
+
+    for( k = 0; k < m; k++ )
+        p += (double)Ai[k]*Aj[k];
+
+    if( std::abs(p) <= eps*std::sqrt((double)a*b) )
+        return false;
+
+    p *= 2;
+    double beta = a - b, gamma = hypot((double)p, beta);
+    if( beta < 0 )
+    {
+        double delta = (gamma - beta)*0.5;
+        s = (_Tp)std::sqrt(delta/gamma);
+        c = (_Tp)(p/(gamma*s*2));
+    }
+    else
+    {
+        c = (_Tp)std::sqrt((gamma + beta)/(gamma*2));
+        s = (_Tp)(p/(gamma*c*2));
+    }
+
+    a = b = 0;
+    for( k = 0; k < m; k++ )
+    {
+        _Tp t0 = c*Ai[k] + s*Aj[k];
+        _Tp t1 = -s*Ai[k] + c*Aj[k];
+        Ai[k] = t0; Aj[k] = t1;
+
+        a += (double)t0*t0; b += (double)t1*t1;
+    }
+    W[i] = a; W[j] = b;
+
+    if( Vt )
+    {
+        _Tp *Vi = Vt + i*vstep, *Vj = Vt + j*vstep;
+        k = vblas.givens(Vi, Vj, n, c, s);
+
+        for( ; k < n; k++ )
+        {
+            _Tp t0 = c*Vi[k] + s*Vj[k];
+            _Tp t1 = -s*Vi[k] + c*Vj[k];
+            Vi[k] = t0; Vj[k] = t1;
+        }
+    }
+    return true;
+}
+
+// larger matrices are processed by the parallel one-sided Jacobi method
+static const int JACOBI_SVD_PARALLEL_MIN_SIZE = 128*128;
+
 template<typename _Tp> void
 JacobiSVDImpl_(_Tp* At, size_t astep, _Tp* _W, _Tp* Vt, size_t vstep,
                int m, int n, int n1, double minval, _Tp eps)
 {
-    VBLAS<_Tp> vblas;
     AutoBuffer<double> Wbuf(n);
     double* W = Wbuf.data();
     int i, j, k, iter, max_iter = std::max(m, 30);
-    _Tp c, s;
+    _Tp s;
     double sd;
     astep /= sizeof(At[0]);
     vstep /= sizeof(Vt[0]);
@@ -389,64 +449,54 @@ JacobiSVDImpl_(_Tp* At, size_t astep, _Tp* _W, _Tp* Vt, size_t vstep,
         }
     }
 
-    for( iter = 0; iter < max_iter; iter++ )
+    if( (int64)m*n >= JACOBI_SVD_PARALLEL_MIN_SIZE && n >= 16 && getNumThreads() > 1 )
     {
-        bool changed = false;
-
-        for( i = 0; i < n-1; i++ )
-            for( j = i+1; j < n; j++ )
-            {
-                _Tp *Ai = At + i*astep, *Aj = At + j*astep;
-                double a = W[i], p = 0, b = W[j];
-
-                for( k = 0; k < m; k++ )
-                    p += (double)Ai[k]*Aj[k];
-
-                if( std::abs(p) <= eps*std::sqrt((double)a*b) )
-                    continue;
-
-                p *= 2;
-                double beta = a - b, gamma = hypot((double)p, beta);
-                if( beta < 0 )
-                {
-                    double delta = (gamma - beta)*0.5;
-                    s = (_Tp)std::sqrt(delta/gamma);
-                    c = (_Tp)(p/(gamma*s*2));
-                }
-                else
-                {
-                    c = (_Tp)std::sqrt((gamma + beta)/(gamma*2));
-                    s = (_Tp)(p/(gamma*c*2));
-                }
-
-                a = b = 0;
-                for( k = 0; k < m; k++ )
-                {
-                    _Tp t0 = c*Ai[k] + s*Aj[k];
-                    _Tp t1 = -s*Ai[k] + c*Aj[k];
-                    Ai[k] = t0; Aj[k] = t1;
-
-                    a += (double)t0*t0; b += (double)t1*t1;
-                }
-                W[i] = a; W[j] = b;
+        // odd-even transposition ordering: every round of a sweep rotates the disjoint pairs of neighbor
+        // rows in parallel and swaps them, so that all the pairs meet once per sweep (R. P. Brent, F. T. Luk,
+        // 1985). It converges in about the same number of sweeps as the cyclic ordering, the result may
+        // differ from the cyclic one within the accuracy of the decomposition.
+        AutoBuffer<int> order(n);
+        for( i = 0; i < n; i++ )
+            order[i] = i;
 
-                changed = true;
+        for( iter = 0; iter < max_iter; iter++ )
+        {
+            std::atomic<bool> changed(false);
 
-                if( Vt )
+            for( int round = 0; round < n; round++ )
+            {
+                const int first = round & 1;
+                parallel_for_(Range(0, (n - first)/2), [&](const Range& range)
                 {
-                    _Tp *Vi = Vt + i*vstep, *Vj = Vt + j*vstep;
-                    k = vblas.givens(Vi, Vj, n, c, s);
-
-                    for( ; k < n; k++ )
+                    bool changed_ = false;
+                    for( int p = range.start; p < range.end; p++ )
                     {
-                        _Tp t0 = c*Vi[k] + s*Vj[k];
-                        _Tp t1 = -s*Vi[k] + c*Vj[k];
-                        Vi[k] = t0; Vj[k] = t1;
+                        int* pair = &order[first + p*2];
+                        changed_ |= JacobiSVDRotate(At, astep, W, Vt, vstep, m, n,
+                                                    std::min(pair[0], pair[1]), std::max(pair[0], pair[1]), eps);
+                        std::swap(pair[0], pair[1]);
                     }
-                }
+                    if( changed_ )
+                        changed = true;
+                });
             }
-        if( !changed )
-            break;
+            if( !changed )
+                break;
+        }
+    }
+    else
+    {
+        for( iter = 0; iter < max_iter; iter++ )
+        {
+            bool changed = false;
+
+            for( i = 0; i < n-1; i++ )
+                for( j = i+1; j < n; j++ )
+                    changed |= JacobiSVDRotate(At, astep, W, Vt, vstep, m, n, i, j, eps);
+
+            if( !changed )
+                break;
+        }
     }
 
     for( i = 0; i < n; i++ )
@@ -728,6 +728,226 @@ static void GEMMStore_64fc( const Complexd* c_data, size_t c_step,
     GEMMStore(c_data, c_step, d_buf, d_buf_step, d_data, d_step, d_size, alpha, beta, flags);
 }
 
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+/* Packed GEMM for real matrices (the same scheme as dnn fast_gemm, see also BLIS):
+   D is split into MC x NC tiles, which are processed in parallel. For each KC-slice of the
+   common dimension the tile blocks of A and B are packed into MR-row and NR-column panels
+   (zero-padded at the borders), and each MR x NR block of D is computed by the register-blocked
+   micro-kernel. */
+enum { GEMM_PACKED_MR = 6, GEMM_PACKED_MC = GEMM_PACKED_MR*12, GEMM_PACKED_NC = 256,
+       GEMM_PACKED_KC_BYTES = 1024 };
+
+static inline v_float32 gemmPackedSetAll(float v) { return vx_setall_f32(v); }
+#if (CV_SIMD_64F || CV_SIMD_SCALABLE_64F)
+static inline v_float64 gemmPackedSetAll(double v) { return vx_setall_f64(v); }
+#endif
+
+// d[0:MR, 0:2*vlanes] += alpha*a*b, a and b are packed panels of kc rows
+template<typename T, typename VT> static void
+gemmPackedMicroKernel( int kc, const T* a, const T* b, T* d, size_t ldd, const VT& v_alpha )
+{
+    const int L = VTraits<VT>::vlanes();
+    VT s00 = gemmPackedSetAll((T)0), s01 = s00, s10 = s00, s11 = s00, s20 = s00, s21 = s00,
+       s30 = s00, s31 = s00, s40 = s00, s41 = s00, s50 = s00, s51 = s00;
+
+    for( int p = 0; p < kc; p++, a += GEMM_PACKED_MR, b += 2*L )
+    {
+        VT b0 = vx_load(b), b1 = vx_load(b + L);
+        VT a0 = gemmPackedSetAll(a[0]);
+        s00 = v_fma(a0, b0, s00); s01 = v_fma(a0, b1, s01);
+        a0 = gemmPackedSetAll(a[1]);
+        s10 = v_fma(a0, b0, s10); s11 = v_fma(a0, b1, s11);
+        a0 = gemmPackedSetAll(a[2]);
+        s20 = v_fma(a0, b0, s20); s21 = v_fma(a0, b1, s21);
+        a0 = gemmPackedSetAll(a[3]);
+        s30 = v_fma(a0, b0, s30); s31 = v_fma(a0, b1, s31);
+        a0 = gemmPackedSetAll(a[4]);
+        s40 = v_fma(a0, b0, s40); s41 = v_fma(a0, b1, s41);
+        a0 = gemmPackedSetAll(a[5]);
+        s50 = v_fma(a0, b0, s50); s51 = v_fma(a0, b1, s51);
+    }
+
+#define CV_GEMM_PACKED_STORE(row) \
+    v_store(d + ldd*row, v_fma(s##row##0, v_alpha, vx_load(d + ldd*row))); \
+    v_store(d + ldd*row + L, v_fma(s##row##1, v_alpha, vx_load(d + ldd*row + L)))
+
+    CV_GEMM_PACKED_STORE(0);
+    CV_GEMM_PACKED_STORE(1);
+    CV_GEMM_PACKED_STORE(2);
+    CV_GEMM_PACKED_STORE(3);
+    CV_GEMM_PACKED_STORE(4);
+    CV_GEMM_PACKED_STORE(5);
+#undef CV_GEMM_PACKED_STORE
+}
+
+// packs A[0:mc, 0:kc] (a(i,k) = A[i*lda0 + k*lda1]) into MR-row panels
+template<typename T> static void
+gemmPackA( int mc, int kc, const T* A, size_t lda0, size_t lda1, T* packA )
+{
+    const int MR = GEMM_PACKED_MR;
+    for( int i = 0; i < mc; i += MR, packA += MR*kc )
+    {
+        int mr = std::min(MR, mc - i);
+        for( int r = 0; r < MR; r++ )
+        {
+            T* dst = packA + r;
+            if( r < mr )
+            {
+                const T* a = A + (i + r)*lda0;
+                for( int p = 0; p < kc; p++ )
+                    dst[p*MR] = a[p*lda1];
+            }
+            else
+            {
+                for( int p = 0; p < kc; p++ )
+                    dst[p*MR] = 0;
+            }
+        }
+    }
+}
+
+// packs B[0:kc, 0:nc] (b(k,j) = B[k*ldb0 + j*ldb1]) into NR-column panels
+template<typename T> static void
+gemmPackB( int nc, int kc, const T* B, size_t ldb0, size_t ldb1, T* packB, int NR )
+{
+    for( int j = 0; j < nc; j += NR, packB += NR*kc )
+    {
+        int nr = std::min(NR, nc - j);
+        const T* b = B + j*ldb1;
+        if( ldb1 == 1 )
+        {
+            for( int p = 0; p < kc; p++ )
+            {
+                memcpy(packB + p*NR, b + p*ldb0, nr*sizeof(T));
+                for( int c = nr; c < NR; c++ )
+                    packB[p*NR + c] = 0;
+            }
+        }
+        else
+        {
+            for( int c = 0; c < NR; c++ )
+            {
+                T* dst = packB + c;
+                if( c < nr )
+                {
+                    const T* bc = b + c*ldb1;
+                    for( int p = 0; p < kc; p++ )
+                        dst[p*NR] = bc[p*ldb0];
+                }
+                else
+                {
+                    for( int p = 0; p < kc; p++ )
+                        dst[p*NR] = 0;
+                }
+            }
+        }
+    }
+}
+
+// D = alpha*A*B + beta*C, a(i,k) = A[i*lda0 + k*lda1], b(k,j) = B[k*ldb0 + j*ldb1], c(i,j) = C[i*ldc0 + j*ldc1]
+template<typename T, typename VT> static void
+gemmPacked( const T* A, size_t lda0, size_t lda1, const T* B, size_t ldb0, size_t ldb1,
+            const T* C, size_t ldc0, size_t ldc1, T* D, size_t ldd,
+            int M, int N, int K, T alpha, T beta )
+{
+    const int MR = GEMM_PACKED_MR, NR = 2*VTraits<VT>::vlanes();
+    const int MC = std::min((int)GEMM_PACKED_MC, (M + MR - 1)/MR*MR);
+    const int NC = std::min(std::max((int)GEMM_PACKED_NC/NR, 1)*NR, (N + NR - 1)/NR*NR);
+    const int KC = std::min((int)(GEMM_PACKED_KC_BYTES/sizeof(T)), K);
+    const int m_tiles = (M + MC - 1)/MC, n_tiles = (N + NC - 1)/NC;
+
+    parallel_for_(Range(0, m_tiles*n_tiles), [&](const Range& range)
+    {
+        AutoBuffer<T> _buf((size_t)KC*(MC + NC) + VTraits<VT>::max_nlanes*2*MR + CV_SIMD_WIDTH);
+        T* packA = alignPtr(_buf.data(), CV_SIMD_WIDTH);
+        T* packB = packA + (size_t)KC*MC;
+        T* tail = packB + (size_t)KC*NC;
+        const VT v_alpha = gemmPackedSetAll(alpha);
+
+        for( int tile = range.start; tile < range.end; tile++ )
+        {
+            int i0 = (tile / n_tiles)*MC, j0 = (tile % n_tiles)*NC;
+            int mc = std::min(MC, M - i0), nc = std::min(NC, N - j0);
+            T* d0 = D + i0*ldd + j0;
+
+            for( int i = 0; i < mc; i++ )
+            {
+                T* d = d0 + i*ldd;
+                if( C && beta != 0 )
+                {
+                    const T* c = C + (i0 + i)*ldc0 + j0*ldc1;
+                    for( int j = 0; j < nc; j++ )
+                        d[j] = c[j*ldc1]*beta;
+                }
+                else
+                    memset(d, 0, nc*sizeof(T));
+            }
+
+            for( int k0 = 0; k0 < K; k0 += KC )
+            {
+                int kc = std::min(KC, K - k0);
+                gemmPackA(mc, kc, A + i0*lda0 + k0*lda1, lda0, lda1, packA);
+                gemmPackB(nc, kc, B + k0*ldb0 + j0*ldb1, ldb0, ldb1, packB, NR);
+
+                for( int j = 0; j < nc; j += NR )
+                {
+                    int nr = std::min(NR, nc - j);
+                    for( int i = 0; i < mc; i += MR )
+                    {
+                        int mr = std::min(MR, mc - i);
+                        const T* pa = packA + i*kc;
+                        const T* pb = packB + j*kc;
+                        T* d = d0 + i*ldd + j;
+                        if( mr == MR && nr == NR )
+                            gemmPackedMicroKernel(kc, pa, pb, d, ldd, v_alpha);
+                        else
+                        {
+                            // border blocks are computed in the temporary buffer
+                            for( int r = 0; r < MR; r++ )
+                                for( int c = 0; c < NR; c++ )
+                                    tail[r*NR + c] = r < mr && c < nr ? d[r*ldd + c] : (T)0;
+                            gemmPackedMicroKernel(kc, pa, pb, tail, (size_t)NR, v_alpha);
+                            for( int r = 0; r < mr; r++ )
+                                for( int c = 0; c < nr; c++ )
+                                    d[r*ldd + c] = tail[r*NR + c];
+                        }
+                    }
+                }
+            }
+        }
+    });
+    vx_cleanup();
+}
+
+template<typename T, typename VT> static void
+gemmPackedImpl( const Mat& A, const Mat& B, double alpha, const Mat& C, double beta, Mat& D,
+                int flags, int len )
+{
+    const size_t esz = sizeof(T);
+    size_t lda0 = A.step/esz, lda1 = 1, ldb0 = B.step/esz, ldb1 = 1, ldc0 = 0, ldc1 = 0;
+    if( flags & GEMM_1_T )
+        std::swap(lda0, lda1);
+    if( flags & GEMM_2_T )
+        std::swap(ldb0, ldb1);
+    if( !C.empty() )
+    {
+        ldc0 = C.step/esz, ldc1 = 1;
+        if( flags & GEMM_3_T )
+            std::swap(ldc0, ldc1);
+    }
+    gemmPacked<T, VT>(A.ptr<T>(), lda0, lda1, B.ptr<T>(), ldb0, ldb1,
+                      C.empty() ? 0 : C.ptr<T>(), ldc0, ldc1, D.ptr<T>(), D.step/esz,
+                      D.rows, D.cols, len, (T)alpha, (T)beta);
+}
+
+// the packed GEMM pays off when all dimensions are large enough for the micro-kernel
+static inline bool useGemmPacked( Size d_size, int len )
+{
+    return d_size.width >= 8 && d_size.height >= 8 && len >= 8 &&
+           (double)d_size.width*d_size.height*len >= 16.*16*16;
+}
+#endif
+
 static void gemmImpl( Mat A, Mat B, double alpha,
            Mat C, double beta, Mat D, int flags )
 {
@@ -762,6 +982,21 @@ static void gemmImpl( Mat A, Mat B, double alpha,
         break;
     }
 
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    if( type == CV_32FC1 && useGemmPacked(d_size, len) )
+    {
+        gemmPackedImpl<float, v_float32>(A, B, alpha, C, beta, D, flags, len);
+        return;
+    }
+#if (CV_SIMD_64F || CV_SIMD_SCALABLE_64F)
+    if( type == CV_64FC1 && useGemmPacked(d_size, len) )
+    {
+        gemmPackedImpl<double, v_float64>(A, B, alpha, C, beta, D, flags, len);
+        return;
+    }
+#endif
+#endif
+
     if( flags == 0 && 2 <= len && len <= 4 && (len == d_size.width || len == d_size.height) )
     {
         if( type == CV_32F )
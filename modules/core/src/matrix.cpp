@@ -4,6 +4,12 @@
 
 #include "precomp.hpp"
 #include "bufferpool.impl.hpp"
+#include "parallel_impl.hpp"
+#include "opencv2/core/utils/arena_allocator.hpp"
+#include "opencv2/core/utils/configuration.private.hpp"
+#include "opencv2/core/utils/tls.hpp"
+
+#include <atomic>
 
 namespace cv {
 
@@ -145,6 +151,15 @@ public:
             total *= sizes[i];
         }
         uchar* data = data0 ? (uchar*)data0 : (uchar*)fastMalloc(total);
+        if (!data0 && dims > 0 && sizes[0] > 1 && isNUMAFirstTouchRequired(total))
+        {
+            // place memory pages on NUMA nodes of threads which are going to process these rows
+            const size_t rowsize = total / sizes[0];
+            parallel_for_(Range(0, sizes[0]), [&](const Range& r)
+            {
+                memset(data + r.start * rowsize, 0, (r.end - r.start) * rowsize);
+            });
+        }
         UMatData* u = new UMatData(this);
         u->data = u->origdata = data;
         u->size = total;
@@ -179,12 +194,33 @@ public:
 static
 MatAllocator*& getDefaultAllocatorMatRef()
 {
-    static MatAllocator* g_matAllocator = Mat::getStdAllocator();
+    static MatAllocator* g_matAllocator = utils::getConfigurationParameterBool("OPENCV_CPU_BUFFERPOOL_ENABLE", false)
+            ? Mat::getBufferPoolAllocator() : Mat::getStdAllocator();
     return g_matAllocator;
 }
 
+struct ThreadMatAllocatorTLS
+{
+    ThreadMatAllocatorTLS() : allocator(NULL) {}
+    MatAllocator* allocator;
+};
+
+static
+TLSData<ThreadMatAllocatorTLS>& getThreadMatAllocatorTLS()
+{
+    CV_SINGLETON_LAZY_INIT_REF(TLSData<ThreadMatAllocatorTLS>, new TLSData<ThreadMatAllocatorTLS>())
+}
+
+static std::atomic<int> g_threadMatAllocatorScopes(0);  // avoid TLS access if scopes are not used
+
 MatAllocator* Mat::getDefaultAllocator()
 {
+    if (g_threadMatAllocatorScopes.load(std::memory_order_relaxed) > 0)
+    {
+        MatAllocator* a = getThreadMatAllocatorTLS().getRef().allocator;
+        if (a)
+            return a;
+    }
     return getDefaultAllocatorMatRef();
 }
 
@@ -198,6 +234,24 @@ MatAllocator* Mat::getStdAllocator()
     CV_SINGLETON_LAZY_INIT(MatAllocator, new StdMatAllocator())
 }
 
+namespace utils {
+
+MatAllocatorScope::MatAllocatorScope(MatAllocator* allocator)
+{
+    ThreadMatAllocatorTLS& tls = getThreadMatAllocatorTLS().getRef();
+    prevAllocator_ = tls.allocator;
+    tls.allocator = allocator;
+    g_threadMatAllocatorScopes++;
+}
+
+MatAllocatorScope::~MatAllocatorScope()
+{
+    getThreadMatAllocatorTLS().getRef().allocator = prevAllocator_;
+    g_threadMatAllocatorScopes--;
+}
+
+} // namespace utils
+
 //==================================================================================================
 
 bool MatSize::operator==(const MatSize& sz) const CV_NOEXCEPT
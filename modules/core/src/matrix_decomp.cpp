@@ -11,6 +11,19 @@ namespace cv { namespace hal {
 *                     LU & Cholesky implementation for small matrices                    *
 \****************************************************************************************/
 
+// the elimination and substitution steps are split between threads when they process at
+// least this number of elements; each element is computed the same way as in a single thread
+static const int DECOMP_PARALLEL_MIN_WORK = 1 << 16;
+
+template<typename Body> static inline void
+decompParallel(const Range& range, int64 work, const Body& body)
+{
+    if( work >= DECOMP_PARALLEL_MIN_WORK && range.size() > 1 && getNumThreads() > 1 )
+        parallel_for_(range, body, (double)std::min(work / DECOMP_PARALLEL_MIN_WORK, (int64)range.size()));
+    else
+        body(range);
+}
+
 template<typename _Tp> static inline int
 LUImpl(_Tp* A, size_t astep, int m, _Tp* b, size_t bstep, int n, _Tp eps)
 {
@@ -39,31 +52,44 @@ LUImpl(_Tp* A, size_t astep, int m, _Tp* b, size_t bstep, int n, _Tp eps)
             p = -p;
         }
 
-        _Tp d = -1/A[i*astep + i];
+        const _Tp d = -1/A[i*astep + i];
+        const _Tp* Ai = A + i*astep;
+        const _Tp* bi = b ? b + i*bstep : 0;
 
-        for( j = i+1; j < m; j++ )
+        decompParallel(Range(i+1, m), (int64)(m - i - 1)*(m - i + (b ? n : 0)), [&](const Range& range)
         {
-            _Tp alpha = A[j*astep + i]*d;
-
-            for( k = i+1; k < m; k++ )
-                A[j*astep + k] += alpha*A[i*astep + k];
-
-            if( b )
-                for( k = 0; k < n; k++ )
-                    b[j*bstep + k] += alpha*b[i*bstep + k];
-        }
+            for( int j1 = range.start; j1 < range.end; j1++ )
+            {
+                _Tp* Aj = A + j1*astep;
+                _Tp alpha = Aj[i]*d;
+
+                for( int k1 = i+1; k1 < m; k1++ )
+                    Aj[k1] += alpha*Ai[k1];
+
+                if( b )
+                {
+                    _Tp* bj = b + j1*bstep;
+                    for( int k1 = 0; k1 < n; k1++ )
+                        bj[k1] += alpha*bi[k1];
+                }
+            }
+        });
     }
 
     if( b )
     {
-        for( i = m-1; i >= 0; i-- )
-            for( j = 0; j < n; j++ )
-            {
-                _Tp s = b[i*bstep + j];
-                for( k = i+1; k < m; k++ )
-                    s -= A[i*astep + k]*b[k*bstep + j];
-                b[i*bstep + j] = s/A[i*astep + i];
-            }
+        // the columns of b are independent
+        decompParallel(Range(0, n), (int64)m*m/2*n, [&](const Range& range)
+        {
+            for( int i1 = m-1; i1 >= 0; i1-- )
+                for( int j1 = range.start; j1 < range.end; j1++ )
+                {
+                    _Tp s = b[i1*bstep + j1];
+                    for( int k1 = i1+1; k1 < m; k1++ )
+                        s -= A[i1*astep + k1]*b[k1*bstep + j1];
+                    b[i1*bstep + j1] = s/A[i1*astep + i1];
+                }
+        });
     }
 
     return p;
@@ -100,24 +126,31 @@ CholImpl(_Tp* A, size_t astep, int m, _Tp* b, size_t bstep, int n)
     astep /= sizeof(A[0]);
     bstep /= sizeof(b[0]);
 
-    for( i = 0; i < m; i++ )
+    // column by column, so that the elements of a column below the diagonal can be computed in parallel
+    for( j = 0; j < m; j++ )
     {
-        for( j = 0; j < i; j++ )
-        {
-            s = A[i*astep + j];
-            for( k = 0; k < j; k++ )
-                s -= L[i*astep + k]*L[j*astep + k];
-            L[i*astep + j] = (_Tp)(s*L[j*astep + j]);
-        }
-        s = A[i*astep + i];
+        s = A[j*astep + j];
         for( k = 0; k < j; k++ )
         {
-            double t = L[i*astep + k];
+            double t = L[j*astep + k];
             s -= t*t;
         }
         if( s < std::numeric_limits<_Tp>::epsilon() )
             return false;
-        L[i*astep + i] = (_Tp)(1./std::sqrt(s));
+        L[j*astep + j] = (_Tp)(1./std::sqrt(s));
+
+        decompParallel(Range(j+1, m), (int64)(m - j - 1)*j, [&](const Range& range)
+        {
+            const _Tp* Lj = L + j*astep;
+            for( int i1 = range.start; i1 < range.end; i1++ )
+            {
+                _Tp* Li = L + i1*astep;
+                double s1 = A[i1*astep + j];
+                for( int k1 = 0; k1 < j; k1++ )
+                    s1 -= Li[k1]*Lj[k1];
+                Li[j] = (_Tp)(s1*Lj[j]);
+            }
+        });
     }
 
     if (!b)
@@ -143,27 +176,31 @@ CholImpl(_Tp* A, size_t astep, int m, _Tp* b, size_t bstep, int n)
      [             L33 ]  x3   y3
      */
 
-    for( i = 0; i < m; i++ )
+    // the columns of b are independent
+    decompParallel(Range(0, n), (int64)m*m*n, [&](const Range& range)
     {
-        for( j = 0; j < n; j++ )
+        for( int i1 = 0; i1 < m; i1++ )
         {
-            s = b[i*bstep + j];
-            for( k = 0; k < i; k++ )
-                s -= L[i*astep + k]*b[k*bstep + j];
-            b[i*bstep + j] = (_Tp)(s*L[i*astep + i]);
+            for( int j1 = range.start; j1 < range.end; j1++ )
+            {
+                double s1 = b[i1*bstep + j1];
+                for( int k1 = 0; k1 < i1; k1++ )
+                    s1 -= L[i1*astep + k1]*b[k1*bstep + j1];
+                b[i1*bstep + j1] = (_Tp)(s1*L[i1*astep + i1]);
+            }
         }
-    }
 
-    for( i = m-1; i >= 0; i-- )
-    {
-        for( j = 0; j < n; j++ )
+        for( int i1 = m-1; i1 >= 0; i1-- )
         {
-            s = b[i*bstep + j];
-            for( k = m-1; k > i; k-- )
-                s -= L[k*astep + i]*b[k*bstep + j];
-            b[i*bstep + j] = (_Tp)(s*L[i*astep + i]);
+            for( int j1 = range.start; j1 < range.end; j1++ )
+            {
+                double s1 = b[i1*bstep + j1];
+                for( int k1 = m-1; k1 > i1; k1-- )
+                    s1 -= L[k1*astep + i1]*b[k1*bstep + j1];
+                b[i1*bstep + j1] = (_Tp)(s1*L[i1*astep + i1]);
+            }
         }
-    }
+    });
     for( i = 0; i < m; i++ )
             L[i*astep + i]=1/L[i*astep + i];
 
@@ -273,6 +310,12 @@ QRImpl(_Tp* A, size_t astep, int m, int n, int k, _Tp* b, size_t bstep, _Tp* hFa
                     b[i*bstep + j] -= 2 * vl[i - l] * v_lB * hFactors[l];
             }
         }
+        //the rank test is relative to the magnitude of R, but not looser than eps
+        _Tp maxDiag = (_Tp)1;
+        for (int i = 0; i < n; i++)
+            maxDiag = std::max(maxDiag, (_Tp)std::abs(A[i*astep + i]));
+        eps *= maxDiag;
+
         //do back substitution
         for (int i = n - 1; i >= 0; i--)
         {
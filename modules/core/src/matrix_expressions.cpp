@@ -11,6 +11,10 @@
 
 #include "precomp.hpp"
 #include <opencv2/core/utils/logger.hpp>
+#include <opencv2/core/utils/configuration.private.hpp>
+#include "opencv2/core/hal/intrin.hpp"
+
+#include <map>
 
 namespace cv
 {
@@ -200,6 +204,63 @@ static MatOp_Initializer* getGlobalMatOpInitializer()
     CV_SINGLETON_LAZY_INIT(MatOp_Initializer, new MatOp_Initializer())
 }
 
+// Node of the fused element-wise expression.
+// Result of each node is saturated to 'depth' - the type of the equivalent non-fused expression.
+struct MatExprNode
+{
+    enum
+    {
+        LOAD = 0,  //!< m
+        ADD,       //!< a*alpha + b*beta + s
+        MUL,       //!< a*b*alpha
+        DIV,       //!< a*alpha/b
+        RECIP,     //!< alpha/a
+        MIN,       //!< min(a, b) or min(a, s)
+        MAX,       //!< max(a, b) or max(a, s)
+        ABSDIFF,   //!< |a - b| or |a - s|
+        CMP        //!< a cmpop b or a cmpop alpha
+    };
+
+    MatExprNode(int _op, int _depth) : op(_op), depth(_depth), cmpop(0), alpha(1), beta(0) {}
+
+    int op;
+    int depth;
+    int cmpop;
+    double alpha, beta;
+    Scalar s;
+    Mat m;
+    Ptr<MatExprNode> a, b;
+};
+
+// Chain of element-wise operations evaluated in a single pass (without temporary matrices)
+class MatOp_Fused CV_FINAL : public MatOp
+{
+public:
+    MatOp_Fused() {}
+    virtual ~MatOp_Fused() {}
+
+    bool elementWise(const MatExpr& /*expr*/) const CV_OVERRIDE { return true; }
+    void assign(const MatExpr& expr, Mat& m, int type=-1) const CV_OVERRIDE;
+
+    void roi(const MatExpr& expr, const Range& rowRange, const Range& colRange, MatExpr& res) const CV_OVERRIDE;
+    void diag(const MatExpr& expr, int d, MatExpr& res) const CV_OVERRIDE;
+
+    void augAssignAdd(const MatExpr& expr, Mat& m) const CV_OVERRIDE;
+    void augAssignSubtract(const MatExpr& expr, Mat& m) const CV_OVERRIDE;
+    void augAssignMultiply(const MatExpr& expr, Mat& m) const CV_OVERRIDE;
+    void augAssignDivide(const MatExpr& expr, Mat& m) const CV_OVERRIDE;
+
+    int type(const MatExpr& expr) const CV_OVERRIDE { return expr.flags; }
+
+    // evaluates the expression into 'm' or converts it into the fused operand 'node' ('m' is set to the operand of the same shape)
+    static void operand(const MatExpr& e, Mat& m, Ptr<MatExprNode>& node);
+    static bool makeExpr(MatExpr& res, int op, Mat& a, Ptr<MatExprNode>& na, Mat& b, Ptr<MatExprNode>& nb,
+                         double alpha=1, double beta=0, const Scalar& s=Scalar(), int cmpop=0);
+    static void makeExpr(MatExpr& res, const Ptr<MatExprNode>& node, const Mat& a);
+};
+
+static MatOp_Fused g_MatOp_Fused;
+
 static inline bool isIdentity(const MatExpr& e) { return e.op == &g_MatOp_Identity; }
 static inline bool isAddEx(const MatExpr& e) { return e.op == &g_MatOp_AddEx; }
 static inline bool isScaled(const MatExpr& e) { return isAddEx(e) && (!e.b.data || e.beta == 0) && e.s == Scalar(); }
@@ -212,6 +273,7 @@ static inline bool isSolve(const MatExpr& e) { return e.op == &g_MatOp_Solve; }
 //static inline bool isGEMM(const MatExpr& e) { return e.op == &g_MatOp_GEMM; }
 static inline bool isMatProd(const MatExpr& e) { return e.op == &g_MatOp_GEMM && (!e.c.data || e.beta == 0); }
 static inline bool isInitializer(const MatExpr& e) { return e.op == getGlobalMatOpInitializer(); }
+static inline bool isFused(const MatExpr& e) { return e.op == &g_MatOp_Fused; }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -332,6 +394,7 @@ void MatOp::add(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
         double alpha = 1, beta = 1;
         Scalar s;
         Mat m1, m2;
+        Ptr<MatExprNode> n1, n2;
         if( isAddEx(e1) && (!e1.b.data || e1.beta == 0) )
         {
             m1 = e1.a;
@@ -339,7 +402,7 @@ void MatOp::add(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
             s = e1.s;
         }
         else
-            e1.op->assign(e1, m1);
+            MatOp_Fused::operand(e1, m1, n1);
 
         if( isAddEx(e2) && (!e2.b.data || e2.beta == 0) )
         {
@@ -348,8 +411,9 @@ void MatOp::add(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
             s += e2.s;
         }
         else
-            e2.op->assign(e2, m2);
-        MatOp_AddEx::makeExpr(res, m1, m2, alpha, beta, s);
+            MatOp_Fused::operand(e2, m2, n2);
+        if( !MatOp_Fused::makeExpr(res, MatExprNode::ADD, m1, n1, m2, n2, alpha, beta, s) )
+            MatOp_AddEx::makeExpr(res, m1, m2, alpha, beta, s);
     }
     else
         e2.op->add(e1, e2, res);
@@ -360,9 +424,11 @@ void MatOp::add(const MatExpr& expr1, const Scalar& s, MatExpr& res) const
 {
     CV_INSTRUMENT_REGION();
 
-    Mat m1;
-    expr1.op->assign(expr1, m1);
-    MatOp_AddEx::makeExpr(res, m1, Mat(), 1, 0, s);
+    Mat m1, m2;
+    Ptr<MatExprNode> n1, n2;
+    MatOp_Fused::operand(expr1, m1, n1);
+    if( !MatOp_Fused::makeExpr(res, MatExprNode::ADD, m1, n1, m2, n2, 1, 0, s) )
+        MatOp_AddEx::makeExpr(res, m1, Mat(), 1, 0, s);
 }
 
 
@@ -375,6 +441,7 @@ void MatOp::subtract(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
         double alpha = 1, beta = -1;
         Scalar s;
         Mat m1, m2;
+        Ptr<MatExprNode> n1, n2;
         if( isAddEx(e1) && (!e1.b.data || e1.beta == 0) )
         {
             m1 = e1.a;
@@ -382,7 +449,7 @@ void MatOp::subtract(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
             s = e1.s;
         }
         else
-            e1.op->assign(e1, m1);
+            MatOp_Fused::operand(e1, m1, n1);
 
         if( isAddEx(e2) && (!e2.b.data || e2.beta == 0) )
         {
@@ -391,8 +458,9 @@ void MatOp::subtract(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
             s -= e2.s;
         }
         else
-            e2.op->assign(e2, m2);
-        MatOp_AddEx::makeExpr(res, m1, m2, alpha, beta, s);
+            MatOp_Fused::operand(e2, m2, n2);
+        if( !MatOp_Fused::makeExpr(res, MatExprNode::ADD, m1, n1, m2, n2, alpha, beta, s) )
+            MatOp_AddEx::makeExpr(res, m1, m2, alpha, beta, s);
     }
     else
         e2.op->subtract(e1, e2, res);
@@ -403,9 +471,11 @@ void MatOp::subtract(const Scalar& s, const MatExpr& expr, MatExpr& res) const
 {
     CV_INSTRUMENT_REGION();
 
-    Mat m;
-    expr.op->assign(expr, m);
-    MatOp_AddEx::makeExpr(res, m, Mat(), -1, 0, s);
+    Mat m, m2;
+    Ptr<MatExprNode> n, n2;
+    MatOp_Fused::operand(expr, m, n);
+    if( !MatOp_Fused::makeExpr(res, MatExprNode::ADD, m, n, m2, n2, -1, 0, s) )
+        MatOp_AddEx::makeExpr(res, m, Mat(), -1, 0, s);
 }
 
 
@@ -416,6 +486,7 @@ void MatOp::multiply(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double
     if( this == e2.op )
     {
         Mat m1, m2;
+        Ptr<MatExprNode> n1, n2;
 
         if( isReciprocal(e1) )
         {
@@ -425,9 +496,11 @@ void MatOp::multiply(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double
                 m2 = e2.a;
             }
             else
-                e2.op->assign(e2, m2);
+                MatOp_Fused::operand(e2, m2, n2);
 
-            MatOp_Bin::makeExpr(res, '/', m2, e1.a, scale/e1.alpha);
+            m1 = e1.a;
+            if( !MatOp_Fused::makeExpr(res, MatExprNode::DIV, m2, n2, m1, n1, scale/e1.alpha) )
+                MatOp_Bin::makeExpr(res, '/', m2, m1, scale/e1.alpha);
         }
         else
         {
@@ -438,7 +511,7 @@ void MatOp::multiply(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double
                 scale *= e1.alpha;
             }
             else
-                e1.op->assign(e1, m1);
+                MatOp_Fused::operand(e1, m1, n1);
 
             if( isScaled(e2) )
             {
@@ -452,9 +525,10 @@ void MatOp::multiply(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double
                 scale *= e2.alpha;
             }
             else
-                e2.op->assign(e2, m2);
+                MatOp_Fused::operand(e2, m2, n2);
 
-            MatOp_Bin::makeExpr(res, op, m1, m2, scale);
+            if( !MatOp_Fused::makeExpr(res, op == '*' ? MatExprNode::MUL : MatExprNode::DIV, m1, n1, m2, n2, scale) )
+                MatOp_Bin::makeExpr(res, op, m1, m2, scale);
         }
     }
     else
@@ -466,9 +540,11 @@ void MatOp::multiply(const MatExpr& expr, double s, MatExpr& res) const
 {
     CV_INSTRUMENT_REGION();
 
-    Mat m;
-    expr.op->assign(expr, m);
-    MatOp_AddEx::makeExpr(res, m, Mat(), s, 0);
+    Mat m, m2;
+    Ptr<MatExprNode> n, n2;
+    MatOp_Fused::operand(expr, m, n);
+    if( !MatOp_Fused::makeExpr(res, MatExprNode::ADD, m, n, m2, n2, s, 0) )
+        MatOp_AddEx::makeExpr(res, m, Mat(), s, 0);
 }
 
 
@@ -483,6 +559,7 @@ void MatOp::divide(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double sc
         else
         {
             Mat m1, m2;
+            Ptr<MatExprNode> n1, n2;
             char op = '/';
 
             if( isScaled(e1) )
@@ -491,7 +568,7 @@ void MatOp::divide(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double sc
                 scale *= e1.alpha;
             }
             else
-                e1.op->assign(e1, m1);
+                MatOp_Fused::operand(e1, m1, n1);
 
             if( isScaled(e2) )
             {
@@ -505,8 +582,9 @@ void MatOp::divide(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double sc
                 op = '*';
             }
             else
-                e2.op->assign(e2, m2);
-            MatOp_Bin::makeExpr(res, op, m1, m2, scale);
+                MatOp_Fused::operand(e2, m2, n2);
+            if( !MatOp_Fused::makeExpr(res, op == '*' ? MatExprNode::MUL : MatExprNode::DIV, m1, n1, m2, n2, scale) )
+                MatOp_Bin::makeExpr(res, op, m1, m2, scale);
         }
     }
     else
@@ -518,9 +596,11 @@ void MatOp::divide(double s, const MatExpr& expr, MatExpr& res) const
 {
     CV_INSTRUMENT_REGION();
 
-    Mat m;
-    expr.op->assign(expr, m);
-    MatOp_Bin::makeExpr(res, '/', m, Mat(), s);
+    Mat m, m2;
+    Ptr<MatExprNode> n, n2;
+    MatOp_Fused::operand(expr, m, n);
+    if( !MatOp_Fused::makeExpr(res, MatExprNode::RECIP, m, n, m2, n2, s) )
+        MatOp_Bin::makeExpr(res, '/', m, Mat(), s);
 }
 
 
@@ -528,9 +608,11 @@ void MatOp::abs(const MatExpr& expr, MatExpr& res) const
 {
     CV_INSTRUMENT_REGION();
 
-    Mat m;
-    expr.op->assign(expr, m);
-    MatOp_Bin::makeExpr(res, 'a', m, Mat());
+    Mat m, m2;
+    Ptr<MatExprNode> n, n2;
+    MatOp_Fused::operand(expr, m, n);
+    if( !MatOp_Fused::makeExpr(res, MatExprNode::ABSDIFF, m, n, m2, n2) )
+        MatOp_Bin::makeExpr(res, 'a', m, Mat());
 }
 
 
@@ -1522,6 +1604,553 @@ inline void MatOp_Cmp::makeExpr(MatExpr& res, int cmpop, const Mat& a, double al
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+static bool isMatExprFusionEnabled()
+{
+    static bool param = utils::getConfigurationParameterBool("OPENCV_MATEXPR_FUSION", true);
+    return param;
+}
+
+static Ptr<MatExprNode> makeFusedLoad(const Mat& m)
+{
+    Ptr<MatExprNode> n = makePtr<MatExprNode>(MatExprNode::LOAD, m.depth());
+    n->m = m;
+    return n;
+}
+
+static Ptr<MatExprNode> makeFusedNode(int op, int depth, const Ptr<MatExprNode>& a, const Ptr<MatExprNode>& b,
+                                      double alpha=1, double beta=0, const Scalar& s=Scalar(), int cmpop=0)
+{
+    Ptr<MatExprNode> n = makePtr<MatExprNode>(op, depth);
+    n->a = a;
+    n->b = b;
+    n->alpha = alpha;
+    n->beta = beta;
+    n->s = s;
+    n->cmpop = cmpop;
+    return n;
+}
+
+static bool isFusableType(int type)
+{
+    return CV_MAT_DEPTH(type) <= CV_64F && CV_MAT_CN(type) <= 4;
+}
+
+// Returns empty pointer if the expression can't be evaluated by the fused kernels
+static Ptr<MatExprNode> makeFusedNode(const MatExpr& e)
+{
+    if( isFused(e) )
+        return e.node;
+    if( !isFusableType(e.a.type()) || (e.b.data && (e.b.type() != e.a.type() || e.b.size != e.a.size)) )
+        return Ptr<MatExprNode>();
+
+    const int depth = e.a.depth();
+    Ptr<MatExprNode> a = makeFusedLoad(e.a), b;
+    if( e.b.data )
+        b = makeFusedLoad(e.b);
+
+    if( isIdentity(e) )
+        return a;
+    if( isAddEx(e) )
+        return makeFusedNode(MatExprNode::ADD, depth, a, b, e.alpha, b ? e.beta : 0,
+                             e.s.isReal() ? Scalar::all(e.s[0]) : e.s);
+    if( isCmp(e) )
+        return makeFusedNode(MatExprNode::CMP, CV_8U, a, b, e.alpha, 0, Scalar(), e.flags);
+    if( e.op == &g_MatOp_Bin )
+    {
+        switch( e.flags )
+        {
+        case '*': return makeFusedNode(MatExprNode::MUL, depth, a, b, e.alpha);
+        case '/': return makeFusedNode(b ? MatExprNode::DIV : MatExprNode::RECIP, depth, a, b, e.alpha);
+        case 'm': return makeFusedNode(MatExprNode::MIN, depth, a, b);
+        case 'M': return makeFusedNode(MatExprNode::MAX, depth, a, b);
+        case 'n': return makeFusedNode(MatExprNode::MIN, depth, a, b, 1, 0, Scalar::all(e.s[0]));
+        case 'N': return makeFusedNode(MatExprNode::MAX, depth, a, b, 1, 0, Scalar::all(e.s[0]));
+        case 'a': return makeFusedNode(MatExprNode::ABSDIFF, depth, a, b, 1, 0, e.s);
+        default: break;
+        }
+    }
+    return Ptr<MatExprNode>();
+}
+
+static Ptr<MatExprNode> fusedNodeRoi(const Ptr<MatExprNode>& node, const Range& rowRange, const Range& colRange)
+{
+    Ptr<MatExprNode> n = makePtr<MatExprNode>(*node);
+    if( node->op == MatExprNode::LOAD )
+        n->m = node->m(rowRange, colRange);
+    if( node->a )
+        n->a = fusedNodeRoi(node->a, rowRange, colRange);
+    if( node->b )
+        n->b = fusedNodeRoi(node->b, rowRange, colRange);
+    return n;
+}
+
+static Ptr<MatExprNode> fusedNodeDiag(const Ptr<MatExprNode>& node, int d)
+{
+    Ptr<MatExprNode> n = makePtr<MatExprNode>(*node);
+    if( node->op == MatExprNode::LOAD )
+        n->m = node->m.diag(d);
+    if( node->a )
+        n->a = fusedNodeDiag(node->a, d);
+    if( node->b )
+        n->b = fusedNodeDiag(node->b, d);
+    return n;
+}
+
+namespace {
+
+// Linear program of the fused expression, evaluated by blocks of BLOCK_SIZE elements.
+// Each node result is kept in the own "register" (buffer of the block size), so intermediate results stay in cache
+struct FusedProgram
+{
+    enum { BLOCK_SIZE = 1024 };
+
+    struct Instr
+    {
+        int op, depth, cmpop;
+        int dst, src1, src2, sreg;  // sreg - register with the per-channel scalar (or -1)
+        double alpha, beta;
+    };
+
+    FusedProgram(const Ptr<MatExprNode>& root, int _cn) : cn(_cn), nregs(0), wdepth(CV_32F)
+    {
+        result = compile(root);
+    }
+
+    int compile(const Ptr<MatExprNode>& node)
+    {
+        std::map<const MatExprNode*, int>::const_iterator it = regs.find(node.get());
+        if( it != regs.end() )
+            return it->second;
+
+        int reg;
+        if( node->op == MatExprNode::LOAD )
+        {
+            const Mat& m = node->m;
+            reg = -1;
+            for( size_t i = 0; i < inputs.size(); i++ )
+                if( inputs[i].data == m.data && inputs[i].type() == m.type() && inputs[i].size == m.size && inputs[i].step == m.step )
+                    reg = inputRegs[i];
+            if( reg < 0 )
+            {
+                reg = nregs++;
+                inputs.push_back(m);
+                inputRegs.push_back(reg);
+            }
+        }
+        else
+        {
+            Instr instr;
+            instr.op = node->op;
+            instr.depth = node->depth;
+            instr.cmpop = node->cmpop;
+            instr.alpha = node->alpha;
+            instr.beta = node->beta;
+            instr.src1 = compile(node->a);
+            instr.src2 = node->b ? compile(node->b) : -1;
+            instr.sreg = -1;
+            if( node->op == MatExprNode::CMP && !node->b )
+                instr.sreg = addConstant(Scalar::all(node->alpha));
+            else if( (node->op == MatExprNode::ADD && node->s != Scalar()) ||
+                     ((node->op == MatExprNode::MIN || node->op == MatExprNode::MAX || node->op == MatExprNode::ABSDIFF) && !node->b) )
+                instr.sreg = addConstant(node->s);
+            instr.dst = nregs++;
+            instrs.push_back(instr);
+            reg = instr.dst;
+        }
+        if( node->depth == CV_32S || node->depth == CV_64F )
+            wdepth = CV_64F;
+        regs[node.get()] = reg;
+        return reg;
+    }
+
+    int addConstant(const Scalar& s)
+    {
+        constants.push_back(s);
+        constRegs.push_back(nregs);
+        return nregs++;
+    }
+
+    int cn;
+    int nregs;
+    int wdepth;  // CV_32F or CV_64F
+    int result;
+    std::vector<Mat> inputs;
+    std::vector<int> inputRegs;
+    std::vector<Scalar> constants;
+    std::vector<int> constRegs;
+    std::vector<Instr> instrs;
+    std::map<const MatExprNode*, int> regs;
+};
+
+template<typename WT> static inline
+WT fusedSaturate(WT v, int depth)
+{
+    switch( depth )
+    {
+    case CV_8U: return (WT)saturate_cast<uchar>(v);
+    case CV_8S: return (WT)saturate_cast<schar>(v);
+    case CV_16U: return (WT)saturate_cast<ushort>(v);
+    case CV_16S: return (WT)saturate_cast<short>(v);
+    case CV_32S: return (WT)saturate_cast<int>(v);
+    case CV_32F: return (WT)(float)v;
+    default: return v;
+    }
+}
+
+template<typename WT> static inline
+bool fusedCompare(WT a, WT b, int cmpop)
+{
+    switch( cmpop )
+    {
+    case CMP_EQ: return a == b;
+    case CMP_GT: return a > b;
+    case CMP_GE: return a >= b;
+    case CMP_LT: return a < b;
+    case CMP_LE: return a <= b;
+    default: return a != b;
+    }
+}
+
+// SIMD parts, return the number of processed elements
+template<typename WT> static inline
+int fusedBinary_SIMD(const FusedProgram::Instr&, const WT*, const WT*, const WT*, WT*, int) { return 0; }
+template<typename WT> static inline
+int fusedSaturate_SIMD(WT*, int, int) { return 0; }
+
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+static int fusedBinary_SIMD(const FusedProgram::Instr& instr, const float* a, const float* b, const float* s, float* d, int n)
+{
+    const int VECSZ = VTraits<v_float32>::vlanes();
+    const v_float32 valpha = vx_setall_f32((float)instr.alpha), vbeta = vx_setall_f32((float)instr.beta);
+    const v_float32 vzero = vx_setzero_f32();
+    const bool intDiv = instr.depth < CV_32F;
+    const float* bs = b ? b : s;
+    int i = 0;
+    switch( instr.op )
+    {
+    case MatExprNode::ADD:
+        for( ; i <= n - VECSZ; i += VECSZ )
+        {
+            v_float32 v = v_mul(vx_load(a + i), valpha);
+            if( b )
+                v = v_fma(vx_load(b + i), vbeta, v);
+            if( s )
+                v = v_add(v, vx_load(s + i));
+            v_store(d + i, v);
+        }
+        break;
+    case MatExprNode::MUL:
+        for( ; i <= n - VECSZ; i += VECSZ )
+            v_store(d + i, v_mul(v_mul(vx_load(a + i), vx_load(bs + i)), valpha));
+        break;
+    case MatExprNode::DIV:
+        for( ; i <= n - VECSZ; i += VECSZ )
+        {
+            v_float32 vb = vx_load(bs + i), v = v_div(v_mul(vx_load(a + i), valpha), vb);
+            v_store(d + i, intDiv ? v_select(v_ne(vb, vzero), v, vzero) : v);
+        }
+        break;
+    case MatExprNode::RECIP:
+        for( ; i <= n - VECSZ; i += VECSZ )
+        {
+            v_float32 va = vx_load(a + i), v = v_div(valpha, va);
+            v_store(d + i, intDiv ? v_select(v_ne(va, vzero), v, vzero) : v);
+        }
+        break;
+    case MatExprNode::MIN:
+        for( ; i <= n - VECSZ; i += VECSZ )
+            v_store(d + i, v_min(vx_load(a + i), vx_load(bs + i)));
+        break;
+    case MatExprNode::MAX:
+        for( ; i <= n - VECSZ; i += VECSZ )
+            v_store(d + i, v_max(vx_load(a + i), vx_load(bs + i)));
+        break;
+    case MatExprNode::ABSDIFF:
+        for( ; i <= n - VECSZ; i += VECSZ )
+            v_store(d + i, v_absdiff(vx_load(a + i), vx_load(bs + i)));
+        break;
+    case MatExprNode::CMP:
+    {
+        const v_float32 v255 = vx_setall_f32(255.f);
+        for( ; i <= n - VECSZ; i += VECSZ )
+        {
+            v_float32 va = vx_load(a + i), vb = vx_load(bs + i), mask;
+            switch( instr.cmpop )
+            {
+            case CMP_EQ: mask = v_eq(va, vb); break;
+            case CMP_GT: mask = v_gt(va, vb); break;
+            case CMP_GE: mask = v_ge(va, vb); break;
+            case CMP_LT: mask = v_lt(va, vb); break;
+            case CMP_LE: mask = v_le(va, vb); break;
+            default: mask = v_ne(va, vb); break;
+            }
+            v_store(d + i, v_and(mask, v255));
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return i;
+}
+
+static int fusedSaturate_SIMD(float* d, int n, int depth)
+{
+    if( depth > CV_16S )
+        return 0;
+    const int VECSZ = VTraits<v_float32>::vlanes();
+    float lo = depth == CV_8U ? 0.f : depth == CV_8S ? -128.f : depth == CV_16U ? 0.f : -32768.f;
+    float hi = depth == CV_8U ? 255.f : depth == CV_8S ? 127.f : depth == CV_16U ? 65535.f : 32767.f;
+    const v_float32 vlo = vx_setall_f32(lo), vhi = vx_setall_f32(hi);
+    int i = 0;
+    for( ; i <= n - VECSZ; i += VECSZ )
+    {
+        v_float32 v = v_min(v_max(vx_load(d + i), vlo), vhi);
+        v_store(d + i, v_cvt_f32(v_round(v)));
+    }
+    return i;
+}
+#endif
+
+template<typename WT> static
+void fusedExecute(const FusedProgram::Instr& instr, WT* regs, int n)
+{
+    const WT* a = regs + (size_t)instr.src1*FusedProgram::BLOCK_SIZE;
+    const WT* b = instr.src2 >= 0 ? regs + (size_t)instr.src2*FusedProgram::BLOCK_SIZE : 0;
+    const WT* s = instr.sreg >= 0 ? regs + (size_t)instr.sreg*FusedProgram::BLOCK_SIZE : 0;
+    WT* d = regs + (size_t)instr.dst*FusedProgram::BLOCK_SIZE;
+    const WT alpha = (WT)instr.alpha, beta = (WT)instr.beta, zero = 0;
+    const bool intDiv = instr.depth < CV_32F;
+
+    const WT* bs = b ? b : s;  // second operand or per-channel scalar
+    int i = fusedBinary_SIMD(instr, a, b, s, d, n);
+    switch( instr.op )
+    {
+    case MatExprNode::ADD:
+        for( ; i < n; i++ )
+            d[i] = a[i]*alpha + (b ? b[i]*beta : zero) + (s ? s[i] : zero);
+        break;
+    case MatExprNode::MUL:
+        for( ; i < n; i++ )
+            d[i] = a[i]*bs[i]*alpha;
+        break;
+    case MatExprNode::DIV:
+        for( ; i < n; i++ )
+            d[i] = intDiv && bs[i] == 0 ? zero : a[i]*alpha/bs[i];
+        break;
+    case MatExprNode::RECIP:
+        for( ; i < n; i++ )
+            d[i] = intDiv && a[i] == 0 ? zero : alpha/a[i];
+        break;
+    case MatExprNode::MIN:
+        for( ; i < n; i++ )
+            d[i] = std::min(a[i], bs[i]);
+        break;
+    case MatExprNode::MAX:
+        for( ; i < n; i++ )
+            d[i] = std::max(a[i], bs[i]);
+        break;
+    case MatExprNode::ABSDIFF:
+        for( ; i < n; i++ )
+            d[i] = std::abs(a[i] - bs[i]);
+        break;
+    case MatExprNode::CMP:
+        for( ; i < n; i++ )
+            d[i] = fusedCompare(a[i], bs[i], instr.cmpop) ? (WT)255 : zero;
+        break;
+    default:
+        CV_Error(cv::Error::StsError, "Unknown operation");
+    }
+
+    if( instr.depth == CV_64F || (instr.depth == CV_32F && sizeof(WT) == sizeof(float)) || instr.op == MatExprNode::CMP )
+        return;
+    i = fusedSaturate_SIMD(d, n, instr.depth);
+    for( ; i < n; i++ )
+        d[i] = fusedSaturate(d[i], instr.depth);
+}
+
+template<typename WT> static
+void fusedRun(const FusedProgram& prog, Mat& dst)
+{
+    const int ninputs = (int)prog.inputs.size();
+    const int cn = prog.cn, blockSize = (FusedProgram::BLOCK_SIZE / cn) * cn;
+    AutoBuffer<WT> _regs((size_t)prog.nregs*FusedProgram::BLOCK_SIZE);
+    WT* regs = _regs.data();
+
+    for( size_t k = 0; k < prog.constants.size(); k++ )
+    {
+        WT* r = regs + (size_t)prog.constRegs[k]*FusedProgram::BLOCK_SIZE;
+        for( int i = 0; i < blockSize; i++ )
+            r[i] = (WT)prog.constants[k][i % cn];
+    }
+
+    std::vector<BinaryFunc> loadFuncs(ninputs);
+    std::vector<size_t> esz(ninputs);
+    std::vector<const Mat*> arrays(ninputs + 2);
+    std::vector<uchar*> ptrs(ninputs + 1);
+    for( int k = 0; k < ninputs; k++ )
+    {
+        loadFuncs[k] = getConvertFunc(prog.inputs[k].depth(), prog.wdepth);
+        esz[k] = prog.inputs[k].elemSize1();
+        arrays[k] = &prog.inputs[k];
+    }
+    arrays[ninputs] = &dst;
+    arrays[ninputs + 1] = 0;
+    BinaryFunc storeFunc = getConvertFunc(prog.wdepth, dst.depth());
+    CV_Assert(storeFunc);
+    const size_t dstesz = dst.elemSize1();
+
+    NAryMatIterator it(&arrays[0], &ptrs[0]);
+    const int total = (int)it.size*cn;
+
+    for( size_t p = 0; p < it.nplanes; p++, ++it )
+    {
+        for( int j = 0; j < total; j += blockSize )
+        {
+            int n = std::min(total - j, blockSize);
+            for( int k = 0; k < ninputs; k++ )
+                loadFuncs[k](ptrs[k] + j*esz[k], 0, 0, 0, (uchar*)(regs + (size_t)prog.inputRegs[k]*FusedProgram::BLOCK_SIZE), 0, Size(n, 1), 0);
+            for( size_t k = 0; k < prog.instrs.size(); k++ )
+                fusedExecute(prog.instrs[k], regs, n);
+            storeFunc((const uchar*)(regs + (size_t)prog.result*FusedProgram::BLOCK_SIZE), 0, 0, 0, ptrs[ninputs] + j*dstesz, 0, Size(n, 1), 0);
+        }
+    }
+}
+
+} // namespace
+
+void MatOp_Fused::assign(const MatExpr& e, Mat& m, int _type) const
+{
+    CV_INSTRUMENT_REGION();
+
+    const int cn = e.a.channels();
+    if( _type == -1 )
+        _type = e.flags;
+    CV_Assert(CV_MAT_CN(_type) == cn);
+
+    FusedProgram prog(e.node, cn);
+    m.create(e.a.dims, e.a.size.p, _type);
+    if( prog.wdepth == CV_32F )
+        fusedRun<float>(prog, m);
+    else
+        fusedRun<double>(prog, m);
+}
+
+void MatOp_Fused::roi(const MatExpr& e, const Range& rowRange, const Range& colRange, MatExpr& res) const
+{
+    makeExpr(res, fusedNodeRoi(e.node, rowRange, colRange), e.a(rowRange, colRange));
+}
+
+void MatOp_Fused::diag(const MatExpr& e, int d, MatExpr& res) const
+{
+    makeExpr(res, fusedNodeDiag(e.node, d), e.a.diag(d));
+}
+
+void MatOp_Fused::augAssignAdd(const MatExpr& e, Mat& m) const
+{
+    MatExpr res;
+    Mat a = m, b = e.a;
+    Ptr<MatExprNode> na, nb = e.node;
+    if( makeExpr(res, MatExprNode::ADD, a, na, b, nb, 1, 1) )
+        assign(res, m);
+    else
+        m += b;
+}
+
+void MatOp_Fused::augAssignSubtract(const MatExpr& e, Mat& m) const
+{
+    MatExpr res;
+    Mat a = m, b = e.a;
+    Ptr<MatExprNode> na, nb = e.node;
+    if( makeExpr(res, MatExprNode::ADD, a, na, b, nb, 1, -1) )
+        assign(res, m);
+    else
+        m -= b;
+}
+
+void MatOp_Fused::augAssignMultiply(const MatExpr& e, Mat& m) const
+{
+    MatExpr res;
+    Mat a = m, b = e.a;
+    Ptr<MatExprNode> na, nb = e.node;
+    if( makeExpr(res, MatExprNode::MUL, a, na, b, nb, 1) )
+        assign(res, m);
+    else
+        m *= b;
+}
+
+void MatOp_Fused::augAssignDivide(const MatExpr& e, Mat& m) const
+{
+    MatExpr res;
+    Mat a = m, b = e.a;
+    Ptr<MatExprNode> na, nb = e.node;
+    if( makeExpr(res, MatExprNode::DIV, a, na, b, nb, 1) )
+        assign(res, m);
+    else
+        m /= b;
+}
+
+void MatOp_Fused::operand(const MatExpr& e, Mat& m, Ptr<MatExprNode>& node)
+{
+    if( !isIdentity(e) && e.op->elementWise(e) && isMatExprFusionEnabled() )
+    {
+        node = makeFusedNode(e);
+        if( node )
+        {
+            m = e.a;
+            return;
+        }
+    }
+    e.op->assign(e, m);
+}
+
+bool MatOp_Fused::makeExpr(MatExpr& res, int op, Mat& a, Ptr<MatExprNode>& na, Mat& b, Ptr<MatExprNode>& nb,
+                           double alpha, double beta, const Scalar& s, int cmpop)
+{
+    if( !na && !nb )
+        return false;
+
+    const int atype = na ? CV_MAKETYPE(na->depth, a.channels()) : a.type();
+    const int btype = nb ? CV_MAKETYPE(nb->depth, b.channels()) : b.type();
+    if( !isFusableType(atype) || (b.data && (btype != atype || b.size != a.size)) )
+    {
+        // let non-fused operations report the error
+        if( na )
+        {
+            Mat m;
+            MatExpr e;
+            makeExpr(e, na, a);
+            e.op->assign(e, m);
+            a = m;
+            na.release();
+        }
+        if( nb )
+        {
+            Mat m;
+            MatExpr e;
+            makeExpr(e, nb, b);
+            e.op->assign(e, m);
+            b = m;
+            nb.release();
+        }
+        return false;
+    }
+
+    Ptr<MatExprNode> node = makeFusedNode(op, op == MatExprNode::CMP ? CV_8U : CV_MAT_DEPTH(atype),
+                                          na ? na : makeFusedLoad(a), b.data ? (nb ? nb : makeFusedLoad(b)) : Ptr<MatExprNode>(),
+                                          alpha, beta, s.isReal() ? Scalar::all(s[0]) : s, cmpop);
+    makeExpr(res, node, a);
+    return true;
+}
+
+void MatOp_Fused::makeExpr(MatExpr& res, const Ptr<MatExprNode>& node, const Mat& a)
+{
+    res = MatExpr(&g_MatOp_Fused, CV_MAKETYPE(node->depth, a.channels()), a);
+    res.node = node;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void MatOp_T::assign(const MatExpr& e, Mat& m, int _type) const
 {
     Mat temp, &dst = _type == -1 || _type == e.a.type() ? m : temp;
@@ -1830,6 +2459,8 @@ void MatExpr::swap(MatExpr& other)
     swap(beta, other.beta);
 
     swap(s, other.s);
+
+    swap(node, other.node);
 }
 
 _InputArray::_InputArray(const MatExpr& expr)
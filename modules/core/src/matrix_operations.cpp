@@ -969,53 +969,367 @@ void cv::reduce(InputArray _src, OutputArray _dst, int dim, int op, int dtype)
 namespace cv
 {
 
-template<typename T> static void sort_( const Mat& src, Mat& dst, int flags )
+enum
 {
-    AutoBuffer<T> buf;
-    int n, len;
-    bool sortRows = (flags & 1) == SORT_EVERY_ROW;
-    bool inplace = src.data == dst.data;
-    bool sortDescending = (flags & SORT_DESCENDING) != 0;
+    SORT_NETWORK_MAX_LEN = 16,
+    SORT_RADIX_MIN_LEN = 256,
+    SORT_PARALLEL_MIN_SIZE = 1 << 16
+};
 
-    if( sortRows )
-        n = src.rows, len = src.cols;
-    else
+// order-preserving mapping of the sorted values to unsigned integer keys
+template<typename T> struct RadixKey;
+
+template<> struct RadixKey<uchar>
+{
+    typedef uchar key_type;
+    static inline uchar encode( uchar v ) { return v; }
+    static inline uchar decode( uchar k ) { return k; }
+};
+
+template<> struct RadixKey<schar>
+{
+    typedef uchar key_type;
+    static inline uchar encode( schar v ) { return (uchar)(v ^ 0x80); }
+    static inline schar decode( uchar k ) { return (schar)(k ^ 0x80); }
+};
+
+template<> struct RadixKey<ushort>
+{
+    typedef ushort key_type;
+    static inline ushort encode( ushort v ) { return v; }
+    static inline ushort decode( ushort k ) { return k; }
+};
+
+template<> struct RadixKey<short>
+{
+    typedef ushort key_type;
+    static inline ushort encode( short v ) { return (ushort)(v ^ 0x8000); }
+    static inline short decode( ushort k ) { return (short)(k ^ 0x8000); }
+};
+
+template<> struct RadixKey<int>
+{
+    typedef unsigned key_type;
+    static inline unsigned encode( int v ) { return (unsigned)v ^ 0x80000000U; }
+    static inline int decode( unsigned k ) { return (int)(k ^ 0x80000000U); }
+};
+
+// negative floats have all the bits inverted, positive ones only the sign bit
+template<> struct RadixKey<float>
+{
+    typedef unsigned key_type;
+    static inline unsigned encode( float v )
     {
-        n = src.cols, len = src.rows;
-        buf.allocate(len);
+        Cv32suf u; u.f = v;
+        return u.u ^ ((unsigned)(u.i >> 31) | 0x80000000U);
     }
-    T* bptr = buf.data();
+    static inline float decode( unsigned k )
+    {
+        Cv32suf u; u.u = k ^ (((k >> 31) - 1) | 0x80000000U);
+        return u.f;
+    }
+};
+
+template<> struct RadixKey<double>
+{
+    typedef uint64 key_type;
+    static inline uint64 encode( double v )
+    {
+        Cv64suf u; u.f = v;
+        return u.u ^ ((uint64)(u.i >> 63) | ((uint64)1 << 63));
+    }
+    static inline double decode( uint64 k )
+    {
+        Cv64suf u; u.u = k ^ (((k >> 63) - 1) | ((uint64)1 << 63));
+        return u.f;
+    }
+};
 
-    for( int i = 0; i < n; i++ )
+/*
+   LSD radix sort of the keys by bytes, with the optional payload idx.
+   All the byte histograms are collected in one pass, and the passes over
+   the bytes that are the same in all the keys are skipped.
+   kbuf and ibuf are the temporary buffers of len elements.
+*/
+template<typename K> static void
+radixSort_( K* keys, K* kbuf, int* idx, int* ibuf, int len )
+{
+    const int nbytes = (int)sizeof(K);
+    AutoBuffer<int> _hist(nbytes*256);
+    int* hist = _hist.data();
+    memset(hist, 0, nbytes*256*sizeof(hist[0]));
+
+    for( int i = 0; i < len; i++ )
     {
-        T* ptr = bptr;
-        if( sortRows )
+        K k = keys[i];
+        for( int b = 0; b < nbytes; b++ )
+            hist[b*256 + (int)((k >> (b*8)) & 255)]++;
+    }
+
+    K* src = keys;
+    K* dst = kbuf;
+    int* isrc = idx;
+    int* idst = ibuf;
+    for( int b = 0; b < nbytes; b++ )
+    {
+        int* h = hist + b*256;
+        int shift = b*8;
+        if( h[(int)((src[0] >> shift) & 255)] == len )
+            continue;
+
+        for( int d = 0, sum = 0; d < 256; d++ )
         {
-            T* dptr = dst.ptr<T>(i);
-            if( !inplace )
+            int c = h[d];
+            h[d] = sum;
+            sum += c;
+        }
+
+        if( idx )
+        {
+            for( int i = 0; i < len; i++ )
             {
-                const T* sptr = src.ptr<T>(i);
-                memcpy(dptr, sptr, sizeof(T) * len);
+                K k = src[i];
+                int pos = h[(int)((k >> shift) & 255)]++;
+                dst[pos] = k;
+                idst[pos] = isrc[i];
             }
-            ptr = dptr;
+            std::swap(isrc, idst);
         }
         else
         {
-            for( int j = 0; j < len; j++ )
-                ptr[j] = src.ptr<T>(j)[i];
+            for( int i = 0; i < len; i++ )
+            {
+                K k = src[i];
+                dst[h[(int)((k >> shift) & 255)]++] = k;
+            }
         }
+        std::swap(src, dst);
+    }
+
+    if( src != keys )
+    {
+        memcpy(keys, src, len*sizeof(K));
+        if( idx )
+            memcpy(idx, isrc, len*sizeof(int));
+    }
+}
 
+// sorts ptr[0..len) in the ascending order; buf should have space for 2*len keys
+template<typename T> static void
+sortArray_( T* ptr, int len, typename RadixKey<T>::key_type* buf )
+{
+    typedef typename RadixKey<T>::key_type K;
+    if( len < SORT_RADIX_MIN_LEN )
+    {
         std::sort( ptr, ptr + len );
-        if( sortDescending )
+        return;
+    }
+
+    if( sizeof(K) == 1 )
+    {
+        // counting sort
+        int hist[256] = {0};
+        for( int i = 0; i < len; i++ )
+            hist[RadixKey<T>::encode(ptr[i])]++;
+        for( int k = 0, i = 0; k < 256; k++ )
+            for( T v = RadixKey<T>::decode((K)k); hist[k] > 0; hist[k]-- )
+                ptr[i++] = v;
+        return;
+    }
+
+    K* keys = buf;
+    for( int i = 0; i < len; i++ )
+        keys[i] = RadixKey<T>::encode(ptr[i]);
+    radixSort_(keys, buf + len, (int*)0, (int*)0, len);
+    for( int i = 0; i < len; i++ )
+        ptr[i] = RadixKey<T>::decode(keys[i]);
+}
+
+/*
+   Batcher's merge-exchange sorting network for n elements
+   (D. Knuth, The Art of Computer Programming, vol. 3, 5.2.2, Algorithm M).
+*/
+static void getSortingNetwork( int n, std::vector<Vec2i>& pairs )
+{
+    pairs.clear();
+    int t = 0;
+    while( (1 << t) < n )
+        t++;
+    for( int p = t > 0 ? 1 << (t - 1) : 0; p > 0; p >>= 1 )
+    {
+        int q = 1 << (t - 1), r = 0, d = p;
+        for(;;)
         {
-            for( int j = 0; j < len/2; j++ )
-                std::swap(ptr[j], ptr[len-1-j]);
+            for( int i = 0; i < n - d; i++ )
+                if( (i & p) == r )
+                    pairs.push_back(Vec2i(i, i + d));
+            if( q == p )
+                break;
+            d = q - p;
+            q >>= 1;
+            r = p;
         }
+    }
+}
 
-        if( !sortRows )
+#if CV_SIMD128
+template<typename T> struct SortVec;
+template<> struct SortVec<uchar> { typedef v_uint8x16 vtype; };
+template<> struct SortVec<schar> { typedef v_int8x16 vtype; };
+template<> struct SortVec<ushort> { typedef v_uint16x8 vtype; };
+template<> struct SortVec<short> { typedef v_int16x8 vtype; };
+template<> struct SortVec<int> { typedef v_int32x4 vtype; };
+template<> struct SortVec<float> { typedef v_float32x4 vtype; };
+#if CV_SIMD128_64F
+template<> struct SortVec<double> { typedef v_float64x2 vtype; };
+#endif
+
+/*
+   Sorts the short rows (columns) i0, i0+1, ... i0+nlanes-1 at once: the lane l
+   of the vector j is the element j of the row (column) i0+l, and the sorting
+   network is applied to the vectors.
+*/
+template<typename T> static void
+sortNetworkBatch_( const Mat& src, Mat& dst, bool sortRows, bool sortDescending,
+                   int i0, int len, const std::vector<Vec2i>& pairs )
+{
+    typedef typename SortVec<T>::vtype V;
+    const int nlanes = VTraits<V>::nlanes;
+    V v[SORT_NETWORK_MAX_LEN];
+    T buf[SORT_NETWORK_MAX_LEN*VTraits<v_uint8x16>::nlanes];
+
+    if( sortRows )
+    {
+        for( int l = 0; l < nlanes; l++ )
+        {
+            const T* sptr = src.ptr<T>(i0 + l);
             for( int j = 0; j < len; j++ )
-                dst.ptr<T>(j)[i] = ptr[j];
+                buf[j*nlanes + l] = sptr[j];
+        }
+        for( int j = 0; j < len; j++ )
+            v[j] = v_load(buf + j*nlanes);
     }
+    else
+    {
+        for( int j = 0; j < len; j++ )
+            v[j] = v_load(src.ptr<T>(j) + i0);
+    }
+
+    for( size_t k = 0; k < pairs.size(); k++ )
+    {
+        V& a = v[pairs[k][0]];
+        V& b = v[pairs[k][1]];
+        V lo = v_min(a, b);
+        b = v_max(a, b);
+        a = lo;
+    }
+    if( sortDescending )
+        std::reverse(v, v + len);
+
+    if( sortRows )
+    {
+        for( int j = 0; j < len; j++ )
+            v_store(buf + j*nlanes, v[j]);
+        for( int l = 0; l < nlanes; l++ )
+        {
+            T* dptr = dst.ptr<T>(i0 + l);
+            for( int j = 0; j < len; j++ )
+                dptr[j] = buf[j*nlanes + l];
+        }
+    }
+    else
+    {
+        for( int j = 0; j < len; j++ )
+            v_store(dst.ptr<T>(j) + i0, v[j]);
+    }
+}
+#endif
+
+template<typename T> static int
+getSortNetworkLanes_()
+{
+#if CV_SIMD128
+    return VTraits<typename SortVec<T>::vtype>::nlanes;
+#else
+    return 0;
+#endif
+}
+
+#if CV_SIMD128 && !CV_SIMD128_64F
+template<> int getSortNetworkLanes_<double>() { return 0; }
+#endif
+
+template<typename T> static void sort_( const Mat& src, Mat& dst, int flags )
+{
+    typedef typename RadixKey<T>::key_type K;
+    int n, len;
+    bool sortRows = (flags & 1) == SORT_EVERY_ROW;
+    bool inplace = src.data == dst.data;
+    bool sortDescending = (flags & SORT_DESCENDING) != 0;
+
+    if( sortRows )
+        n = src.rows, len = src.cols;
+    else
+        n = src.cols, len = src.rows;
+
+    // many short rows (columns) are sorted by a SIMD sorting network, several at once
+    int nlanes = getSortNetworkLanes_<T>();
+    std::vector<Vec2i> pairs;
+    if( nlanes > 0 && len > 1 && len <= SORT_NETWORK_MAX_LEN && n >= nlanes )
+        getSortingNetwork(len, pairs);
+    else
+        nlanes = 0;
+
+    parallel_for_(Range(0, n), [&](const Range& range)
+    {
+        AutoBuffer<T> buf;
+        AutoBuffer<K> kbuf;
+        if( !sortRows )
+            buf.allocate(len);
+        if( len >= SORT_RADIX_MIN_LEN )
+            kbuf.allocate(len*2);
+        T* bptr = buf.data();
+        int i = range.start;
+
+#if CV_SIMD128
+        if( nlanes > 0 )
+        {
+            for( ; i <= range.end - nlanes; i += nlanes )
+                sortNetworkBatch_<T>(src, dst, sortRows, sortDescending, i, len, pairs);
+        }
+#endif
+
+        for( ; i < range.end; i++ )
+        {
+            T* ptr = bptr;
+            if( sortRows )
+            {
+                T* dptr = dst.ptr<T>(i);
+                if( !inplace )
+                {
+                    const T* sptr = src.ptr<T>(i);
+                    memcpy(dptr, sptr, sizeof(T) * len);
+                }
+                ptr = dptr;
+            }
+            else
+            {
+                for( int j = 0; j < len; j++ )
+                    ptr[j] = src.ptr<T>(j)[i];
+            }
+
+            sortArray_( ptr, len, kbuf.data() );
+            if( sortDescending )
+            {
+                for( int j = 0; j < len/2; j++ )
+                    std::swap(ptr[j], ptr[len-1-j]);
+            }
+
+            if( !sortRows )
+                for( int j = 0; j < len; j++ )
+                    dst.ptr<T>(j)[i] = ptr[j];
+        }
+    }, (double)n*len >= SORT_PARALLEL_MIN_SIZE ? std::min((double)n, (double)n*len/(SORT_PARALLEL_MIN_SIZE/4)) : 1.);
 }
 
 #ifdef HAVE_IPP
@@ -1114,10 +1428,79 @@ public:
     const _Tp* arr;
 };
 
+// the total order used by topK: by the value, then by the position
+template<typename _Tp> class LessThanIdxStable
+{
+public:
+    LessThanIdxStable( const _Tp* _arr ) : arr(_arr) {}
+    bool operator()(int a, int b) const { return arr[a] < arr[b] || (arr[a] == arr[b] && a < b); }
+    const _Tp* arr;
+};
+
+template<typename _Tp> class GreaterThanIdxStable
+{
+public:
+    GreaterThanIdxStable( const _Tp* _arr ) : arr(_arr) {}
+    bool operator()(int a, int b) const { return arr[a] > arr[b] || (arr[a] == arr[b] && a < b); }
+    const _Tp* arr;
+};
+
+template<typename T> static void topK_( const Mat& src, Mat& values, Mat& indices, int k, int flags )
+{
+    bool sortRows = (flags & 1) == SORT_EVERY_ROW;
+    bool sortDescending = (flags & SORT_DESCENDING) != 0;
+    int n = sortRows ? src.rows : src.cols, len = sortRows ? src.cols : src.rows;
+
+    parallel_for_(Range(0, n), [&](const Range& range)
+    {
+        AutoBuffer<T> buf;
+        AutoBuffer<int> ibuf(len);
+        if( !sortRows )
+            buf.allocate(len);
+        int* iptr = ibuf.data();
+
+        for( int i = range.start; i < range.end; i++ )
+        {
+            const T* ptr = buf.data();
+            if( sortRows )
+                ptr = src.ptr<T>(i);
+            else
+            {
+                for( int j = 0; j < len; j++ )
+                    buf[j] = src.ptr<T>(j)[i];
+            }
+            for( int j = 0; j < len; j++ )
+                iptr[j] = j;
+
+            if( sortDescending )
+            {
+                GreaterThanIdxStable<T> cmp(ptr);
+                if( k < len )
+                    std::nth_element(iptr, iptr + k - 1, iptr + len, cmp);
+                std::sort(iptr, iptr + k, cmp);
+            }
+            else
+            {
+                LessThanIdxStable<T> cmp(ptr);
+                if( k < len )
+                    std::nth_element(iptr, iptr + k - 1, iptr + len, cmp);
+                std::sort(iptr, iptr + k, cmp);
+            }
+
+            for( int j = 0; j < k; j++ )
+            {
+                if( !values.empty() )
+                    (sortRows ? values.ptr<T>(i)[j] : values.ptr<T>(j)[i]) = ptr[iptr[j]];
+                if( !indices.empty() )
+                    (sortRows ? indices.ptr<int>(i)[j] : indices.ptr<int>(j)[i]) = iptr[j];
+            }
+        }
+    }, (double)n*len >= SORT_PARALLEL_MIN_SIZE ? std::min((double)n, (double)n*len/(SORT_PARALLEL_MIN_SIZE/4)) : 1.);
+}
+
 template<typename T> static void sortIdx_( const Mat& src, Mat& dst, int flags )
 {
-    AutoBuffer<T> buf;
-    AutoBuffer<int> ibuf;
+    typedef typename RadixKey<T>::key_type K;
     bool sortRows = (flags & 1) == SORT_EVERY_ROW;
     bool sortDescending = (flags & SORT_DESCENDING) != 0;
 
@@ -1127,43 +1510,66 @@ template<typename T> static void sortIdx_( const Mat& src, Mat& dst, int flags )
     if( sortRows )
         n = src.rows, len = src.cols;
     else
-    {
         n = src.cols, len = src.rows;
-        buf.allocate(len);
-        ibuf.allocate(len);
-    }
-    T* bptr = buf.data();
-    int* _iptr = ibuf.data();
 
-    for( int i = 0; i < n; i++ )
+    parallel_for_(Range(0, n), [&](const Range& range)
     {
-        T* ptr = bptr;
-        int* iptr = _iptr;
-
-        if( sortRows )
+        AutoBuffer<T> buf;
+        AutoBuffer<int> ibuf;
+        AutoBuffer<K> kbuf;
+        AutoBuffer<int> tbuf;
+        if( !sortRows )
         {
-            ptr = (T*)(src.data + src.step*i);
-            iptr = dst.ptr<int>(i);
+            buf.allocate(len);
+            ibuf.allocate(len);
         }
-        else
+        bool radix = len >= SORT_RADIX_MIN_LEN;
+        if( radix )
         {
-            for( int j = 0; j < len; j++ )
-                ptr[j] = src.ptr<T>(j)[i];
+            kbuf.allocate(len*2);
+            tbuf.allocate(len);
         }
-        for( int j = 0; j < len; j++ )
-            iptr[j] = j;
+        T* bptr = buf.data();
+        int* _iptr = ibuf.data();
 
-        std::sort( iptr, iptr + len, LessThanIdx<T>(ptr) );
-        if( sortDescending )
+        for( int i = range.start; i < range.end; i++ )
         {
-            for( int j = 0; j < len/2; j++ )
-                std::swap(iptr[j], iptr[len-1-j]);
-        }
+            T* ptr = bptr;
+            int* iptr = _iptr;
 
-        if( !sortRows )
+            if( sortRows )
+            {
+                ptr = (T*)(src.data + src.step*i);
+                iptr = dst.ptr<int>(i);
+            }
+            else
+            {
+                for( int j = 0; j < len; j++ )
+                    ptr[j] = src.ptr<T>(j)[i];
+            }
             for( int j = 0; j < len; j++ )
-                dst.ptr<int>(j)[i] = iptr[j];
-    }
+                iptr[j] = j;
+
+            if( radix )
+            {
+                K* keys = kbuf.data();
+                for( int j = 0; j < len; j++ )
+                    keys[j] = RadixKey<T>::encode(ptr[j]);
+                radixSort_(keys, keys + len, iptr, tbuf.data(), len);
+            }
+            else
+                std::sort( iptr, iptr + len, LessThanIdx<T>(ptr) );
+            if( sortDescending )
+            {
+                for( int j = 0; j < len/2; j++ )
+                    std::swap(iptr[j], iptr[len-1-j]);
+            }
+
+            if( !sortRows )
+                for( int j = 0; j < len; j++ )
+                    dst.ptr<int>(j)[i] = iptr[j];
+        }
+    }, (double)n*len >= SORT_PARALLEL_MIN_SIZE ? std::min((double)n, (double)n*len/(SORT_PARALLEL_MIN_SIZE/4)) : 1.);
 }
 
 #ifdef HAVE_IPP
@@ -1293,3 +1699,45 @@ void cv::sortIdx( InputArray _src, OutputArray _dst, int flags )
     CV_Assert( func != 0 );
     func( src, dst, flags );
 }
+
+namespace cv
+{
+typedef void (*TopKFunc)(const Mat& src, Mat& values, Mat& indices, int k, int flags);
+}
+
+void cv::topK( InputArray _src, OutputArray _values, OutputArray _indices, int k, int flags )
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat src = _src.getMat();
+    CV_Assert( src.dims <= 2 && src.channels() == 1 );
+    bool sortRows = (flags & 1) == SORT_EVERY_ROW;
+    int n = sortRows ? src.rows : src.cols, len = sortRows ? src.cols : src.rows;
+    CV_Assert( 0 < k && k <= len );
+    Size dsize = sortRows ? Size(k, n) : Size(n, k);
+
+    Mat values, indices;
+    if( _values.needed() )
+    {
+        if( _values.getMat().data == src.data )
+            _values.release();
+        _values.create( dsize, src.type() );
+        values = _values.getMat();
+    }
+    if( _indices.needed() )
+    {
+        _indices.create( dsize, CV_32S );
+        indices = _indices.getMat();
+    }
+    if( values.empty() && indices.empty() )
+        return;
+
+    static TopKFunc tab[CV_DEPTH_MAX] =
+    {
+        topK_<uchar>, topK_<schar>, topK_<ushort>, topK_<short>,
+        topK_<int>, topK_<float>, topK_<double>, 0
+    };
+    TopKFunc func = tab[src.depth()];
+    CV_Assert( func != 0 );
+    func( src, values, indices, k, flags );
+}
@@ -14,8 +14,13 @@ namespace cv {
 
 ////////////////////////////////////// transpose /////////////////////////////////////////
 
+// The arrays are transposed by square tiles of about TRANSPOSE_TILE_BYTES per row,
+// which fit into L1 cache. For 1-, 2- and 4-byte elements the tiles are transposed by
+// blocks of vectors in registers. Large arrays are processed by stripes of tiles in parallel.
+enum { TRANSPOSE_TILE_BYTES = 256, TRANSFORM_PARALLEL_MIN_SIZE = 1 << 17 };
+
 template<typename T> static void
-transpose_( const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz )
+transpose_( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz )
 {
     int i=0, j, m = sz.width, n = sz.height;
 
@@ -82,20 +87,154 @@ transposeI_( uchar* data, size_t step, int n )
     }
 }
 
-typedef void (*TransposeFunc)( const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz );
+// swaps the block a with the transposed block b (of the same square matrix), sz is the size of a
+template<typename T> static void
+transposeSwap_( uchar* a, uchar* b, size_t step, Size sz )
+{
+    for( int i = 0; i < sz.height; i++ )
+    {
+        T* row = (T*)(a + step*i);
+        uchar* col = b + i*sizeof(T);
+        for( int j = 0; j < sz.width; j++ )
+            std::swap( row[j], *(T*)(col + step*j) );
+    }
+}
+
+#if CV_SIMD128
+// transposes nlanes x nlanes block in registers with the perfect shuffle:
+// log2(nlanes) rounds of interleaving the rows of the first half with the rows of the second half
+template<typename V> static inline void
+transposeBlock_( V* r )
+{
+    const int n = V::nlanes;
+    V t[V::nlanes];
+    for( int k = 1; k < n; k *= 2 )
+    {
+        for( int i = 0; i < n/2; i++ )
+            v_zip(r[i], r[i + n/2], t[i*2], t[i*2 + 1]);
+        for( int i = 0; i < n; i++ )
+            r[i] = t[i];
+    }
+}
+
+template<typename V> static void
+transposeSIMD_( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz )
+{
+    typedef typename V::lane_type T;
+    const int n = V::nlanes;
+    int m0 = sz.width - sz.width % n, n0 = sz.height - sz.height % n;
+
+    for( int i = 0; i < m0; i += n )
+        for( int j = 0; j < n0; j += n )
+        {
+            V r[V::nlanes];
+            for( int k = 0; k < n; k++ )
+                r[k] = v_load((const T*)(src + sstep*(j + k)) + i);
+            transposeBlock_(r);
+            for( int k = 0; k < n; k++ )
+                v_store((T*)(dst + dstep*(i + k)) + j, r[k]);
+        }
+
+    if( m0 < sz.width )
+        transpose_<T>(src + m0*sizeof(T), sstep, dst + dstep*m0, dstep, Size(sz.width - m0, sz.height));
+    if( n0 < sz.height )
+        transpose_<T>(src + sstep*n0, sstep, dst + n0*sizeof(T), dstep, Size(m0, sz.height - n0));
+}
+
+template<typename V> static void
+transposeSwapSIMD_( uchar* a, uchar* b, size_t step, Size sz )
+{
+    typedef typename V::lane_type T;
+    const int n = V::nlanes;
+    int w0 = sz.width - sz.width % n, h0 = sz.height - sz.height % n;
+
+    for( int i = 0; i < h0; i += n )
+        for( int j = 0; j < w0; j += n )
+        {
+            V ra[V::nlanes], rb[V::nlanes];
+            for( int k = 0; k < n; k++ )
+            {
+                ra[k] = v_load((const T*)(a + step*(i + k)) + j);
+                rb[k] = v_load((const T*)(b + step*(j + k)) + i);
+            }
+            transposeBlock_(ra);
+            transposeBlock_(rb);
+            for( int k = 0; k < n; k++ )
+            {
+                v_store((T*)(a + step*(i + k)) + j, rb[k]);
+                v_store((T*)(b + step*(j + k)) + i, ra[k]);
+            }
+        }
+
+    if( w0 < sz.width )
+        transposeSwap_<T>(a + w0*sizeof(T), b + step*w0, step, Size(sz.width - w0, sz.height));
+    if( h0 < sz.height )
+        transposeSwap_<T>(a + step*h0, b + h0*sizeof(T), step, Size(w0, sz.height - h0));
+}
+#endif
+
+// fallbacks for the element sizes without a specialized implementation
+static void
+transposeAny_( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz, size_t esz )
+{
+    for( int i = 0; i < sz.width; i++ )
+    {
+        uchar* d = dst + dstep*i;
+        for( int j = 0; j < sz.height; j++ )
+            memcpy(d + j*esz, src + sstep*j + i*esz, esz);
+    }
+}
+
+static void
+transposeSwapAny_( uchar* a, uchar* b, size_t step, Size sz, size_t esz )
+{
+    for( int i = 0; i < sz.height; i++ )
+        for( int j = 0; j < sz.width; j++ )
+        {
+            uchar* p = a + step*i + j*esz;
+            std::swap_ranges(p, p + esz, b + step*j + i*esz);
+        }
+}
+
+static void
+transposeIAny_( uchar* data, size_t step, int n, size_t esz )
+{
+    for( int i = 0; i < n; i++ )
+        transposeSwapAny_(data + step*i + (i + 1)*esz, data + step*(i + 1) + i*esz, step, Size(n - i - 1, 1), esz);
+}
+
+typedef void (*TransposeFunc)( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz );
 typedef void (*TransposeInplaceFunc)( uchar* data, size_t step, int n );
+typedef void (*TransposeSwapFunc)( uchar* a, uchar* b, size_t step, Size sz );
 
 #define DEF_TRANSPOSE_FUNC(suffix, type) \
-static void transpose_##suffix( const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz ) \
+static void transpose_##suffix( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz ) \
 { transpose_<type>(src, sstep, dst, dstep, sz); } \
 \
 static void transposeI_##suffix( uchar* data, size_t step, int n ) \
-{ transposeI_<type>(data, step, n); }
+{ transposeI_<type>(data, step, n); } \
+\
+static void transposeSwap_##suffix( uchar* a, uchar* b, size_t step, Size sz ) \
+{ transposeSwap_<type>(a, b, step, sz); }
 
-DEF_TRANSPOSE_FUNC(8u, uchar)
-DEF_TRANSPOSE_FUNC(16u, ushort)
+#if CV_SIMD128
+#define DEF_TRANSPOSE_FUNC_SIMD(suffix, type, vtype) \
+static void transpose_##suffix( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz ) \
+{ transposeSIMD_<vtype>(src, sstep, dst, dstep, sz); } \
+\
+static void transposeI_##suffix( uchar* data, size_t step, int n ) \
+{ transposeI_<type>(data, step, n); } \
+\
+static void transposeSwap_##suffix( uchar* a, uchar* b, size_t step, Size sz ) \
+{ transposeSwapSIMD_<vtype>(a, b, step, sz); }
+#else
+#define DEF_TRANSPOSE_FUNC_SIMD(suffix, type, vtype) DEF_TRANSPOSE_FUNC(suffix, type)
+#endif
+
+DEF_TRANSPOSE_FUNC_SIMD(8u, uchar, v_uint8x16)
+DEF_TRANSPOSE_FUNC_SIMD(16u, ushort, v_uint16x8)
 DEF_TRANSPOSE_FUNC(8uC3, Vec3b)
-DEF_TRANSPOSE_FUNC(32s, int)
+DEF_TRANSPOSE_FUNC_SIMD(32s, unsigned, v_uint32x4)
 DEF_TRANSPOSE_FUNC(16uC3, Vec3s)
 DEF_TRANSPOSE_FUNC(32sC2, Vec2i)
 DEF_TRANSPOSE_FUNC(32sC3, Vec3i)
@@ -117,6 +256,86 @@ static TransposeInplaceFunc transposeInplaceTab[] =
     0, 0, 0, 0, 0, 0, 0, transposeI_32sC6, 0, 0, 0, 0, 0, 0, 0, transposeI_32sC8
 };
 
+static TransposeSwapFunc transposeSwapTab[] =
+{
+    0, transposeSwap_8u, transposeSwap_16u, transposeSwap_8uC3, transposeSwap_32s, 0, transposeSwap_16uC3, 0,
+    transposeSwap_32sC2, 0, 0, 0, transposeSwap_32sC3, 0, 0, 0, transposeSwap_32sC4,
+    0, 0, 0, 0, 0, 0, 0, transposeSwap_32sC6, 0, 0, 0, 0, 0, 0, 0, transposeSwap_32sC8
+};
+
+static inline int transposeTileSize( size_t esz )
+{
+    return std::max(TRANSPOSE_TILE_BYTES/(int)esz, 16);
+}
+
+static inline void transformParallel( int n, size_t size, const std::function<void(const Range&)>& body )
+{
+    if( size >= (size_t)TRANSFORM_PARALLEL_MIN_SIZE && n > 1 )
+        parallel_for_(Range(0, n), body);
+    else
+        body(Range(0, n));
+}
+
+// transposes src of size sz to dst; the steps may be negative, e.g. to rotate the array
+static void
+transposeTiled( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz, size_t esz )
+{
+    TransposeFunc func = esz < sizeof(transposeTab)/sizeof(transposeTab[0]) ? transposeTab[esz] : 0;
+    const int tile = transposeTileSize(esz);
+    // the element-wise copy is faster with the long runs of the destination rows
+    const int tileRows = CV_SIMD128 && (esz == 1 || esz == 2 || esz == 4) ? tile : sz.height;
+
+    transformParallel((sz.width + tile - 1)/tile, (size_t)sz.width*sz.height*esz, [&](const Range& r)
+    {
+        for( int i = r.start*tile; i < std::min(r.end*tile, sz.width); i += tile )
+            for( int j = 0; j < sz.height; j += tileRows )
+            {
+                const uchar* s = src + sstep*j + i*esz;
+                uchar* d = dst + dstep*i + j*esz;
+                Size tsz(std::min(tile, sz.width - i), std::min(tileRows, sz.height - j));
+                if( func )
+                    func(s, sstep, d, dstep, tsz);
+                else
+                    transposeAny_(s, sstep, d, dstep, tsz, esz);
+            }
+    });
+}
+
+// in-place transposition of n x n matrix: the diagonal tiles are transposed in place,
+// the other ones are swapped with their transposed counterparts
+static void
+transposeInplaceTiled( uchar* data, size_t step, int n, size_t esz )
+{
+    bool tab = esz < sizeof(transposeTab)/sizeof(transposeTab[0]);
+    TransposeInplaceFunc ifunc = tab ? transposeInplaceTab[esz] : 0;
+    TransposeSwapFunc sfunc = tab ? transposeSwapTab[esz] : 0;
+    const int tile = transposeTileSize(esz);
+
+    transformParallel((n + tile - 1)/tile, (size_t)n*n*esz, [&](const Range& r)
+    {
+        for( int i = r.start*tile; i < std::min(r.end*tile, n); i += tile )
+        {
+            int h = std::min(tile, n - i);
+            uchar* diag = data + step*i + i*esz;
+            if( ifunc )
+                ifunc(diag, step, h);
+            else
+                transposeIAny_(diag, step, h, esz);
+
+            for( int j = i + tile; j < n; j += tile )
+            {
+                uchar* a = data + step*i + j*esz;
+                uchar* b = data + step*j + i*esz;
+                Size tsz(std::min(tile, n - j), h);
+                if( sfunc )
+                    sfunc(a, b, step, tsz);
+                else
+                    transposeSwapAny_(a, b, step, tsz, esz);
+            }
+        }
+    });
+}
+
 #ifdef HAVE_OPENCL
 
 static bool ocl_transpose( InputArray _src, OutputArray _dst )
@@ -275,17 +494,11 @@ void transpose( InputArray _src, OutputArray _dst )
 
     if( dst.data == src.data )
     {
-        TransposeInplaceFunc func = transposeInplaceTab[esz];
-        CV_Assert( func != 0 );
         CV_Assert( dst.cols == dst.rows );
-        func( dst.ptr(), dst.step, dst.rows );
+        transposeInplaceTiled( dst.ptr(), dst.step, dst.rows, esz );
     }
     else
-    {
-        TransposeFunc func = transposeTab[esz];
-        CV_Assert( func != 0 );
-        func( src.ptr(), src.step, dst.ptr(), dst.step, src.size() );
-    }
+        transposeTiled( src.ptr(), (ptrdiff_t)src.step, dst.ptr(), (ptrdiff_t)dst.step, src.size(), esz );
 }
 
 
@@ -589,14 +802,17 @@ flipHoriz( const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size size,
     }
 }
 
+// swaps the rows y and size.height-1-y for y from the pairs range
 static void
-flipVert( const uchar* src0, size_t sstep, uchar* dst0, size_t dstep, Size size, size_t esz )
+flipVert( const uchar* src0, size_t sstep, uchar* dst0, size_t dstep, Size size, size_t esz, const Range& pairs )
 {
-    const uchar* src1 = src0 + (size.height - 1)*sstep;
-    uchar* dst1 = dst0 + (size.height - 1)*dstep;
+    const uchar* src1 = src0 + (size.height - 1 - pairs.start)*sstep;
+    uchar* dst1 = dst0 + (size.height - 1 - pairs.start)*dstep;
+    src0 += pairs.start*sstep;
+    dst0 += pairs.start*dstep;
     size.width *= (int)esz;
 
-    for( int y = 0; y < (size.height + 1)/2; y++, src0 += sstep, src1 -= sstep,
+    for( int y = pairs.start; y < pairs.end; y++, src0 += sstep, src1 -= sstep,
                                                   dst0 += dstep, dst1 -= dstep )
     {
         int i = 0;
@@ -812,13 +1028,29 @@ void flip( InputArray _src, OutputArray _dst, int flip_mode )
 
     size_t esz = CV_ELEM_SIZE(type);
 
-    if( flip_mode <= 0 )
-        flipVert( src.ptr(), src.step, dst.ptr(), dst.step, src.size(), esz );
-    else
-        flipHoriz( src.ptr(), src.step, dst.ptr(), dst.step, src.size(), esz );
+    // the stripes of rows (or of the row pairs, swapped by flipVert) are processed in parallel
+    int height = size.height, nrows = flip_mode <= 0 ? (height + 1)/2 : height;
+    transformParallel(nrows, (size_t)size.width*size.height*esz, [&](const Range& r)
+    {
+        if( flip_mode > 0 )
+        {
+            flipHoriz( src.ptr(r.start), src.step, dst.ptr(r.start), dst.step,
+                       Size(size.width, r.end - r.start), esz );
+            return;
+        }
 
-    if( flip_mode < 0 )
-        flipHoriz( dst.ptr(), dst.step, dst.ptr(), dst.step, dst.size(), esz );
+        flipVert( src.ptr(), src.step, dst.ptr(), dst.step, size, esz, r );
+        if( flip_mode < 0 )
+        {
+            // flip the just swapped rows while they are in cache; the middle row is flipped once
+            int y1 = std::max(height - r.end, r.end);
+            flipHoriz( dst.ptr(r.start), dst.step, dst.ptr(r.start), dst.step,
+                       Size(size.width, r.end - r.start), esz );
+            if( y1 < height - r.start )
+                flipHoriz( dst.ptr(y1), dst.step, dst.ptr(y1), dst.step,
+                           Size(size.width, height - r.start - y1), esz );
+        }
+    });
 }
 
 static void
@@ -1144,6 +1376,18 @@ void rotate(InputArray _src, OutputArray _dst, int rotateMode)
     CALL_HAL(rotate90, cv_hal_rotate90, type, src.ptr(), src.step, src.cols, src.rows,
              dst.ptr(), dst.step, angle);
 
+    // 90 degrees rotations are done in one pass as transpositions with the reversed row order
+    // of the source (clockwise) or of the destination (counterclockwise)
+    if( (angle == 90 || angle == 270) && dst.data != src.data )
+    {
+        size_t esz = src.elemSize();
+        if( angle == 90 )
+            transposeTiled( src.ptr(src.rows - 1), -(ptrdiff_t)src.step, dst.ptr(), (ptrdiff_t)dst.step, src.size(), esz );
+        else
+            transposeTiled( src.ptr(), (ptrdiff_t)src.step, dst.ptr(dst.rows - 1), -(ptrdiff_t)dst.step, src.size(), esz );
+        return;
+    }
+
     // use src (Mat) since _src (InputArray) is updated by _dst.create() when in-place
     rotateImpl(src, _dst, rotateMode);
 }
@@ -122,18 +122,31 @@ static bool ipp_mean( Mat &src, Mat &mask, Scalar &ret )
 }
 #endif
 
-Scalar mean(InputArray _src, InputArray _mask)
+namespace {
+
+// per-channel sums and the number of non-masked pixels
+struct MeanSums
 {
-    CV_INSTRUMENT_REGION();
+    MeanSums() : nz(0) {}
 
-    Mat src = _src.getMat(), mask = _mask.getMat();
-    CV_Assert( mask.empty() || mask.type() == CV_8U );
+    MeanSums& operator += (const MeanSums& b)
+    {
+        s += b.s;
+        nz += b.nz;
+        return *this;
+    }
 
-    int k, cn = src.channels(), depth = src.depth();
     Scalar s;
+    size_t nz;
+};
 
-    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_mean(src, mask, s), s)
+}
 
+static MeanSums meanSums_(const Mat& src, const Mat& mask)
+{
+    MeanSums sums;
+    Scalar& s = sums.s;
+    int k, cn = src.channels(), depth = src.depth();
     SumFunc func = getSumFunc(depth);
 
     CV_Assert( cn <= 4 && func != 0 );
@@ -182,7 +195,29 @@ Scalar mean(InputArray _src, InputArray _mask)
                 ptrs[1] += bsz;
         }
     }
-    return s*(nz0 ? 1./nz0 : 0);
+    sums.nz = nz0;
+    return sums;
+}
+
+Scalar mean(InputArray _src, InputArray _mask)
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat src = _src.getMat(), mask = _mask.getMat();
+    CV_Assert( mask.empty() || mask.type() == CV_8U );
+
+#if defined HAVE_IPP
+    Scalar s;
+    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_mean(src, mask, s), s)
+#endif
+
+    MeanSums sums;
+    const Mat* arrays[] = {&src, &mask, 0};
+    if( !parallelReduce(arrays, sums,
+                        [](const Mat* chunks, size_t) { return meanSums_(chunks[0], chunks[1]); },
+                        [](MeanSums& a, const MeanSums& b) { a += b; }) )
+        sums = meanSums_(src, mask);
+    return sums.s*(sums.nz ? 1./sums.nz : 0);
 }
 
 static SumSqrFunc getSumSqrFunc(int depth)
@@ -513,6 +548,101 @@ static bool ipp_meanStdDev(Mat& src, OutputArray _mean, OutputArray _sdv, Mat& m
 }
 #endif
 
+namespace {
+
+// per-channel sums, sums of squares and the number of non-masked pixels
+struct MeanStdDevSums
+{
+    MeanStdDevSums() : nz(0) {}
+
+    MeanStdDevSums& operator += (const MeanStdDevSums& b)
+    {
+        s.resize(b.s.size());
+        sq.resize(b.sq.size());
+        for( size_t k = 0; k < s.size(); k++ )
+        {
+            s[k] += b.s[k];
+            sq[k] += b.sq[k];
+        }
+        nz += b.nz;
+        return *this;
+    }
+
+    std::vector<double> s, sq;
+    size_t nz;
+};
+
+}
+
+static MeanStdDevSums meanStdDevSums_(const Mat& src, const Mat& mask)
+{
+    int k, cn = src.channels(), depth = src.depth();
+    MeanStdDevSums sums;
+    SumSqrFunc func = getSumSqrFunc(depth);
+
+    CV_Assert( func != 0 );
+
+    const Mat* arrays[] = {&src, &mask, 0};
+    uchar* ptrs[2] = {};
+    NAryMatIterator it(arrays, ptrs);
+    int total = (int)it.size, blockSize = total, intSumBlockSize = 0;
+    int j, count = 0;
+    size_t nz0 = 0;
+    AutoBuffer<double> _buf(cn*2);
+    sums.s.assign(cn, 0.);
+    sums.sq.assign(cn, 0.);
+    double *s = sums.s.data(), *sq = sums.sq.data();
+    int *sbuf = (int*)s, *sqbuf = (int*)sq;
+    bool blockSum = depth <= CV_16S, blockSqSum = depth <= CV_8S;
+    size_t esz = 0;
+
+    if( blockSum )
+    {
+        intSumBlockSize = 1 << 15;
+        blockSize = std::min(blockSize, intSumBlockSize);
+        sbuf = (int*)_buf.data();
+        if( blockSqSum )
+            sqbuf = sbuf + cn;
+        for( k = 0; k < cn; k++ )
+            sbuf[k] = sqbuf[k] = 0;
+        esz = src.elemSize();
+    }
+
+    for( size_t i = 0; i < it.nplanes; i++, ++it )
+    {
+        for( j = 0; j < total; j += blockSize )
+        {
+            int bsz = std::min(total - j, blockSize);
+            int nz = func( ptrs[0], ptrs[1], (uchar*)sbuf, (uchar*)sqbuf, bsz, cn );
+            count += nz;
+            nz0 += nz;
+            if( blockSum && (count + blockSize >= intSumBlockSize || (i+1 >= it.nplanes && j+bsz >= total)) )
+            {
+                for( k = 0; k < cn; k++ )
+                {
+                    s[k] += sbuf[k];
+                    sbuf[k] = 0;
+                }
+                if( blockSqSum )
+                {
+                    for( k = 0; k < cn; k++ )
+                    {
+                        sq[k] += sqbuf[k];
+                        sqbuf[k] = 0;
+                    }
+                }
+                count = 0;
+            }
+            ptrs[0] += bsz*esz;
+            if( ptrs[1] )
+                ptrs[1] += bsz;
+        }
+    }
+
+    sums.nz = nz0;
+    return sums;
+}
+
 void meanStdDev(InputArray _src, OutputArray _mean, OutputArray _sdv, InputArray _mask)
 {
     CV_INSTRUMENT_REGION();
@@ -532,7 +662,7 @@ void meanStdDev(InputArray _src, OutputArray _mean, OutputArray _sdv, InputArray
 
     CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_meanStdDev(src, _mean, _sdv, mask));
 
-    int k, cn = src.channels(), depth = src.depth();
+    int k, cn = src.channels();
     Mat mean_mat, stddev_mat;
 
     if(_mean.needed())
@@ -584,68 +714,15 @@ void meanStdDev(InputArray _src, OutputArray _mean, OutputArray _sdv, InputArray
         }
     }
 
-    SumSqrFunc func = getSumSqrFunc(depth);
-
-    CV_Assert( func != 0 );
-
+    MeanStdDevSums sums;
     const Mat* arrays[] = {&src, &mask, 0};
-    uchar* ptrs[2] = {};
-    NAryMatIterator it(arrays, ptrs);
-    int total = (int)it.size, blockSize = total, intSumBlockSize = 0;
-    int j, count = 0, nz0 = 0;
-    AutoBuffer<double> _buf(cn*4);
-    double *s = (double*)_buf.data(), *sq = s + cn;
-    int *sbuf = (int*)s, *sqbuf = (int*)sq;
-    bool blockSum = depth <= CV_16S, blockSqSum = depth <= CV_8S;
-    size_t esz = 0;
-
-    for( k = 0; k < cn; k++ )
-        s[k] = sq[k] = 0;
-
-    if( blockSum )
-    {
-        intSumBlockSize = 1 << 15;
-        blockSize = std::min(blockSize, intSumBlockSize);
-        sbuf = (int*)(sq + cn);
-        if( blockSqSum )
-            sqbuf = sbuf + cn;
-        for( k = 0; k < cn; k++ )
-            sbuf[k] = sqbuf[k] = 0;
-        esz = src.elemSize();
-    }
-
-    for( size_t i = 0; i < it.nplanes; i++, ++it )
-    {
-        for( j = 0; j < total; j += blockSize )
-        {
-            int bsz = std::min(total - j, blockSize);
-            int nz = func( ptrs[0], ptrs[1], (uchar*)sbuf, (uchar*)sqbuf, bsz, cn );
-            count += nz;
-            nz0 += nz;
-            if( blockSum && (count + blockSize >= intSumBlockSize || (i+1 >= it.nplanes && j+bsz >= total)) )
-            {
-                for( k = 0; k < cn; k++ )
-                {
-                    s[k] += sbuf[k];
-                    sbuf[k] = 0;
-                }
-                if( blockSqSum )
-                {
-                    for( k = 0; k < cn; k++ )
-                    {
-                        sq[k] += sqbuf[k];
-                        sqbuf[k] = 0;
-                    }
-                }
-                count = 0;
-            }
-            ptrs[0] += bsz*esz;
-            if( ptrs[1] )
-                ptrs[1] += bsz;
-        }
-    }
+    if( !parallelReduce(arrays, sums,
+                        [](const Mat* chunks, size_t) { return meanStdDevSums_(chunks[0], chunks[1]); },
+                        [](MeanStdDevSums& a, const MeanStdDevSums& b) { a += b; }) )
+        sums = meanStdDevSums_(src, mask);
 
-    double scale = nz0 ? 1./nz0 : 0.;
+    double *s = sums.s.data(), *sq = sums.sq.data();
+    double scale = sums.nz ? 1./sums.nz : 0.;
     for( k = 0; k < cn; k++ )
     {
         s[k] *= scale;
@@ -1495,6 +1495,54 @@ static bool ipp_minMaxIdx(Mat &src, double* _minVal, double* _maxVal, int* _minI
 }
 #endif
 
+namespace {
+
+struct MinMaxIdxResult
+{
+    double minVal, maxVal;
+    size_t minIdx, maxIdx; // 1-based offsets, 0 if not found
+};
+
+}
+
+// startidx is the 1-based offset of the first src element
+static MinMaxIdxResult minMaxIdx_(const Mat& src, const Mat& mask, size_t startidx)
+{
+    int depth = src.depth(), cn = src.channels();
+    MinMaxIdxFunc func = getMinmaxTab(depth);
+    CV_Assert( func != 0 );
+
+    const Mat* arrays[] = {&src, &mask, 0};
+    uchar* ptrs[2] = {};
+    NAryMatIterator it(arrays, ptrs);
+
+    size_t minidx = 0, maxidx = 0;
+    int iminval = INT_MAX, imaxval = INT_MIN;
+    float  fminval = std::numeric_limits<float>::infinity(),  fmaxval = -fminval;
+    double dminval = std::numeric_limits<double>::infinity(), dmaxval = -dminval;
+    int *minval = &iminval, *maxval = &imaxval;
+    int planeSize = (int)it.size*cn;
+
+    if( depth == CV_32F )
+        minval = (int*)&fminval, maxval = (int*)&fmaxval;
+    else if( depth == CV_64F )
+        minval = (int*)&dminval, maxval = (int*)&dmaxval;
+
+    for( size_t i = 0; i < it.nplanes; i++, ++it, startidx += planeSize )
+        func( ptrs[0], ptrs[1], minval, maxval, &minidx, &maxidx, planeSize, startidx );
+
+    MinMaxIdxResult res;
+    if( depth == CV_32F )
+        dminval = fminval, dmaxval = fmaxval;
+    else if( depth <= CV_32S )
+        dminval = iminval, dmaxval = imaxval;
+    res.minVal = dminval;
+    res.maxVal = dmaxval;
+    res.minIdx = minidx;
+    res.maxIdx = maxidx;
+    return res;
+}
+
 }
 
 void cv::minMaxIdx(InputArray _src, double* minVal,
@@ -1543,28 +1591,27 @@ void cv::minMaxIdx(InputArray _src, double* minVal,
 
     CV_IPP_RUN_FAST(ipp_minMaxIdx(src, minVal, maxVal, minIdx, maxIdx, mask))
 
-    MinMaxIdxFunc func = getMinmaxTab(depth);
-    CV_Assert( func != 0 );
+    MinMaxIdxResult res;
+    res.minVal = depth <= CV_32S ? (double)INT_MAX : std::numeric_limits<double>::infinity();
+    res.maxVal = depth <= CV_32S ? (double)INT_MIN : -std::numeric_limits<double>::infinity();
+    res.minIdx = res.maxIdx = 0;
 
+    // each chunk finds its own extremums, they are merged in the chunk order,
+    // so ties are resolved in favor of the earliest chunk as in the plain loop
     const Mat* arrays[] = {&src, &mask, 0};
-    uchar* ptrs[2] = {};
-    NAryMatIterator it(arrays, ptrs);
-
-    size_t minidx = 0, maxidx = 0;
-    int iminval = INT_MAX, imaxval = INT_MIN;
-    float  fminval = std::numeric_limits<float>::infinity(),  fmaxval = -fminval;
-    double dminval = std::numeric_limits<double>::infinity(), dmaxval = -dminval;
-    size_t startidx = 1;
-    int *minval = &iminval, *maxval = &imaxval;
-    int planeSize = (int)it.size*cn;
-
-    if( depth == CV_32F )
-        minval = (int*)&fminval, maxval = (int*)&fmaxval;
-    else if( depth == CV_64F )
-        minval = (int*)&dminval, maxval = (int*)&dmaxval;
-
-    for( size_t i = 0; i < it.nplanes; i++, ++it, startidx += planeSize )
-        func( ptrs[0], ptrs[1], minval, maxval, &minidx, &maxidx, planeSize, startidx );
+    if( !parallelReduce(arrays, res,
+                        [cn](const Mat* chunks, size_t startIdx) { return minMaxIdx_(chunks[0], chunks[1], startIdx*cn + 1); },
+                        [](MinMaxIdxResult& a, const MinMaxIdxResult& b)
+                        {
+                            if( b.minIdx != 0 && (a.minIdx == 0 || b.minVal < a.minVal) )
+                                a.minVal = b.minVal, a.minIdx = b.minIdx;
+                            if( b.maxIdx != 0 && (a.maxIdx == 0 || b.maxVal > a.maxVal) )
+                                a.maxVal = b.maxVal, a.maxIdx = b.maxIdx;
+                        }) )
+        res = minMaxIdx_(src, mask, 1);
+
+    size_t minidx = res.minIdx, maxidx = res.maxIdx;
+    double dminval = res.minVal, dmaxval = res.maxVal;
 
     if (!src.empty() && mask.empty())
     {
@@ -1576,10 +1623,6 @@ void cv::minMaxIdx(InputArray _src, double* minVal,
 
     if( minidx == 0 )
         dminval = dmaxval = 0;
-    else if( depth == CV_32F )
-        dminval = fminval, dmaxval = fmaxval;
-    else if( depth <= CV_32S )
-        dminval = iminval, dmaxval = imaxval;
 
     if( minVal )
         *minVal = dminval;
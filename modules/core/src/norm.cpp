@@ -600,28 +600,8 @@ static bool ipp_norm(Mat &src, int normType, Mat &mask, double &result)
 }  // ipp_norm()
 #endif  // HAVE_IPP
 
-double norm( InputArray _src, int normType, InputArray _mask )
+static double norm_(const Mat& src, int normType, const Mat& mask)
 {
-    CV_INSTRUMENT_REGION();
-
-    normType &= NORM_TYPE_MASK;
-    CV_Assert( normType == NORM_INF || normType == NORM_L1 ||
-               normType == NORM_L2 || normType == NORM_L2SQR ||
-               ((normType == NORM_HAMMING || normType == NORM_HAMMING2) && _src.type() == CV_8U) );
-
-#if defined HAVE_OPENCL || defined HAVE_IPP
-    double _result = 0;
-#endif
-
-#ifdef HAVE_OPENCL
-    CV_OCL_RUN_(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2,
-                ocl_norm(_src, normType, _mask, _result),
-                _result)
-#endif
-
-    Mat src = _src.getMat(), mask = _mask.getMat();
-    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_norm(src, normType, mask, _result), _result);
-
     int depth = src.depth(), cn = src.channels();
     if( src.isContinuous() && mask.empty() )
     {
@@ -790,6 +770,39 @@ double norm( InputArray _src, int normType, InputArray _mask )
     return result.d;
 }
 
+double norm( InputArray _src, int normType, InputArray _mask )
+{
+    CV_INSTRUMENT_REGION();
+
+    normType &= NORM_TYPE_MASK;
+    CV_Assert( normType == NORM_INF || normType == NORM_L1 ||
+               normType == NORM_L2 || normType == NORM_L2SQR ||
+               ((normType == NORM_HAMMING || normType == NORM_HAMMING2) && _src.type() == CV_8U) );
+
+#if defined HAVE_OPENCL || defined HAVE_IPP
+    double _result = 0;
+#endif
+
+#ifdef HAVE_OPENCL
+    CV_OCL_RUN_(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2,
+                ocl_norm(_src, normType, _mask, _result),
+                _result)
+#endif
+
+    Mat src = _src.getMat(), mask = _mask.getMat();
+    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_norm(src, normType, mask, _result), _result);
+
+    // L2 is accumulated over the chunks as L2SQR
+    int chunkNormType = normType == NORM_L2 ? NORM_L2SQR : normType;
+    double result = 0;
+    const Mat* arrays[] = {&src, &mask, 0};
+    if( parallelReduce(arrays, result,
+                       [chunkNormType](const Mat* chunks, size_t) { return norm_(chunks[0], chunkNormType, chunks[1]); },
+                       [chunkNormType](double& a, double b) { a = chunkNormType == NORM_INF ? std::max(a, b) : a + b; }) )
+        return normType == NORM_L2 ? std::sqrt(result) : result;
+    return norm_(src, normType, mask);
+}
+
 //==================================================================================================
 
 #ifdef HAVE_OPENCL
@@ -1070,38 +1083,10 @@ static bool ipp_norm(InputArray _src1, InputArray _src2, int normType, InputArra
 #endif  // HAVE_IPP
 
 
-double norm( InputArray _src1, InputArray _src2, int normType, InputArray _mask )
+static double normDiff_(const Mat& src1, const Mat& src2, int normType, const Mat& mask)
 {
-    CV_INSTRUMENT_REGION();
-
-    CV_CheckTypeEQ(_src1.type(), _src2.type(), "Input type mismatch");
-    CV_Assert(_src1.sameSize(_src2));
-
-#if defined HAVE_OPENCL || defined HAVE_IPP
-    double _result = 0;
-#endif
-
-#ifdef HAVE_OPENCL
-    CV_OCL_RUN_(OCL_PERFORMANCE_CHECK(_src1.isUMat()),
-                ocl_norm(_src1, _src2, normType, _mask, _result),
-                _result)
-#endif
-
-    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_norm(_src1, _src2, normType, _mask, _result), _result);
-
-    if( normType & CV_RELATIVE )
-    {
-        return norm(_src1, _src2, normType & ~CV_RELATIVE, _mask)/(norm(_src2, normType, _mask) + DBL_EPSILON);
-    }
-
-    Mat src1 = _src1.getMat(), src2 = _src2.getMat(), mask = _mask.getMat();
     int depth = src1.depth(), cn = src1.channels();
 
-    normType &= 7;
-    CV_Assert( normType == NORM_INF || normType == NORM_L1 ||
-               normType == NORM_L2 || normType == NORM_L2SQR ||
-              ((normType == NORM_HAMMING || normType == NORM_HAMMING2) && src1.type() == CV_8U) );
-
     if( src1.isContinuous() && src2.isContinuous() && mask.empty() )
     {
         size_t len = src1.total()*src1.channels();
@@ -1262,6 +1247,48 @@ double norm( InputArray _src1, InputArray _src2, int normType, InputArray _mask
     return result.d;
 }
 
+double norm( InputArray _src1, InputArray _src2, int normType, InputArray _mask )
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_CheckTypeEQ(_src1.type(), _src2.type(), "Input type mismatch");
+    CV_Assert(_src1.sameSize(_src2));
+
+#if defined HAVE_OPENCL || defined HAVE_IPP
+    double _result = 0;
+#endif
+
+#ifdef HAVE_OPENCL
+    CV_OCL_RUN_(OCL_PERFORMANCE_CHECK(_src1.isUMat()),
+                ocl_norm(_src1, _src2, normType, _mask, _result),
+                _result)
+#endif
+
+    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_norm(_src1, _src2, normType, _mask, _result), _result);
+
+    if( normType & CV_RELATIVE )
+    {
+        return norm(_src1, _src2, normType & ~CV_RELATIVE, _mask)/(norm(_src2, normType, _mask) + DBL_EPSILON);
+    }
+
+    Mat src1 = _src1.getMat(), src2 = _src2.getMat(), mask = _mask.getMat();
+
+    normType &= 7;
+    CV_Assert( normType == NORM_INF || normType == NORM_L1 ||
+               normType == NORM_L2 || normType == NORM_L2SQR ||
+              ((normType == NORM_HAMMING || normType == NORM_HAMMING2) && src1.type() == CV_8U) );
+
+    // L2 is accumulated over the chunks as L2SQR
+    int chunkNormType = normType == NORM_L2 ? NORM_L2SQR : normType;
+    double result = 0;
+    const Mat* arrays[] = {&src1, &src2, &mask, 0};
+    if( parallelReduce(arrays, result,
+                       [chunkNormType](const Mat* chunks, size_t) { return normDiff_(chunks[0], chunks[1], chunkNormType, chunks[2]); },
+                       [chunkNormType](double& a, double b) { a = chunkNormType == NORM_INF ? std::max(a, b) : a + b; }) )
+        return normType == NORM_L2 ? std::sqrt(result) : result;
+    return normDiff_(src1, src2, normType, mask);
+}
+
 cv::Hamming::ResultType Hamming::operator()( const unsigned char* a, const unsigned char* b, int size ) const
 {
     return cv::hal::normHamming(a, b, size);
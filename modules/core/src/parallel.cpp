@@ -151,6 +151,7 @@
 #  define CV_PARALLEL_FRAMEWORK "ms-concurrency"
 #elif defined HAVE_PTHREADS_PF
 #  define CV_PARALLEL_FRAMEWORK "pthreads"
+#  define CV_PARALLEL_FRAMEWORK_PTHREADS 1
 #endif
 
 #include <atomic>
@@ -534,6 +535,12 @@ void parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body, dou
             throw;
         }
     }
+#ifdef CV_PARALLEL_FRAMEWORK_PTHREADS
+    else if (parallel_pthreads_is_nested_region()) // work-stealing thread pool is able to run nested jobs
+    {
+        parallel_for_impl(range, body, nstripes);
+    }
+#endif
     else // nested parallel_for_() calls are not parallelized
     {
         CV_UNUSED(nstripes);
@@ -713,6 +720,16 @@ unsigned defaultNumberOfThreads()
     return result;
 }
 
+bool isNUMAFirstTouchRequired(size_t size)
+{
+#ifdef CV_PARALLEL_FRAMEWORK_PTHREADS
+    if (!getCurrentParallelForAPI())
+        return parallel_pthreads_numa_first_touch_required(size);
+#endif
+    CV_UNUSED(size);
+    return false;
+}
+
 void setNumThreads( int threads_ )
 {
     CV_UNUSED(threads_);
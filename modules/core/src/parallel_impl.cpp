@@ -17,6 +17,15 @@
 #include <opencv2/core/utils/logger.hpp>
 
 #include <opencv2/core/utils/trace.private.hpp>
+#include <opencv2/core/utils/tls.hpp>
+
+#include <deque>
+#include <fstream>
+
+#if defined __linux__ && defined _GNU_SOURCE && !defined __ANDROID__
+#include <sched.h>
+#define CV_HAVE_NUMA_TOPOLOGY 1
+#endif
 
 //#define CV_PROFILE_THREADS 64
 //#define getTickCount getCPUTickCount  // use this if getTickCount() calls are expensive (and getCPUTickCount() is accurate)
@@ -79,8 +88,242 @@ static int CV_MAIN_THREAD_ACTIVE_WAIT = (int)utils::getConfigurationParameterSiz
 
 static int CV_WORKER_ACTIVE_WAIT_THREADS_LIMIT = (int)utils::getConfigurationParameterSizeT("OPENCV_THREAD_POOL_ACTIVE_WAIT_THREADS_LIMIT", 0); // number of real cores
 
+// Work-stealing scheduler: per-thread task deques, nested parallel_for_() calls are executed in parallel
+static bool CV_THREAD_POOL_WORK_STEALING = utils::getConfigurationParameterBool("OPENCV_THREAD_POOL_WORK_STEALING", false);
+
+// NUMA-aware mode: workers are bound to NUMA nodes, job ranges are split between nodes
+static bool CV_THREAD_POOL_NUMA = utils::getConfigurationParameterBool("OPENCV_THREAD_POOL_NUMA", false);
+static size_t CV_THREAD_POOL_NUMA_FIRST_TOUCH_THRESHOLD = utils::getConfigurationParameterSizeT("OPENCV_THREAD_POOL_NUMA_FIRST_TOUCH_THRESHOLD", 4 << 20);  // bytes
+
+#ifdef CV_HAVE_NUMA_TOPOLOGY
+// parse string of form "0-1,3,5-7,10,13-15"
+static std::vector<int> parseCPUList(const std::string& str)
+{
+    std::vector<int> res;
+    size_t pos = 0;
+    while (pos < str.size())
+    {
+        size_t next = str.find(',', pos);
+        if (next == std::string::npos)
+            next = str.size();
+        int rstart = -1, rend = -1;
+        int n = sscanf(str.substr(pos, next - pos).c_str(), "%d-%d", &rstart, &rend);
+        if (n == 1)
+            rend = rstart;
+        for (int i = rstart; n >= 1 && rstart >= 0 && i <= rend; i++)
+            res.push_back(i);
+        pos = next + 1;
+    }
+    return res;
+}
+
+static std::string readSysFile(const std::string& filename)
+{
+    std::ifstream ifs(filename.c_str());
+    std::string content;
+    std::getline(ifs, content);
+    return ifs.fail() ? std::string() : content;
+}
+
+class NUMATopology
+{
+public:
+    static const NUMATopology& instance()
+    {
+        CV_SINGLETON_LAZY_INIT_REF(NUMATopology, new NUMATopology())
+    }
+
+    std::vector<cpu_set_t> node_cpus;  // CPUs available for the process, per NUMA node (empty nodes are skipped)
+    std::vector<int> cpu_node;  // CPU => node index
+
+    int currentNode() const
+    {
+        int cpu = sched_getcpu();
+        if (cpu < 0 || cpu >= (int)cpu_node.size() || cpu_node[cpu] < 0)
+            return 0;
+        return cpu_node[cpu];
+    }
+
+private:
+    NUMATopology()
+    {
+        cpu_set_t process_cpus;
+        CPU_ZERO(&process_cpus);
+        if (0 != sched_getaffinity(0, sizeof(process_cpus), &process_cpus))
+            return;
+        std::vector<int> nodes = parseCPUList(readSysFile("/sys/devices/system/node/online"));
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            std::vector<int> cpus = parseCPUList(readSysFile(cv::format("/sys/devices/system/node/node%d/cpulist", nodes[i])));
+            cpu_set_t node_set;
+            CPU_ZERO(&node_set);
+            for (size_t j = 0; j < cpus.size(); j++)
+            {
+                if (cpus[j] < CPU_SETSIZE && CPU_ISSET(cpus[j], &process_cpus))
+                    CPU_SET(cpus[j], &node_set);
+            }
+            if (CPU_COUNT(&node_set) == 0)
+                continue;
+            for (size_t j = 0; j < cpus.size(); j++)
+            {
+                if (CPU_ISSET(cpus[j], &node_set))
+                {
+                    if ((int)cpu_node.size() <= cpus[j])
+                        cpu_node.resize(cpus[j] + 1, -1);
+                    cpu_node[cpus[j]] = (int)node_cpus.size();
+                }
+            }
+            node_cpus.push_back(node_set);
+        }
+        CV_LOG_INFO(NULL, "NUMA: detected " << node_cpus.size() << " node(s) with available CPUs");
+    }
+};
+#endif // CV_HAVE_NUMA_TOPOLOGY
+
+static unsigned getNUMANodesCount()
+{
+#ifdef CV_HAVE_NUMA_TOPOLOGY
+    return (unsigned)std::max((size_t)1, NUMATopology::instance().node_cpus.size());
+#else
+    return 1;
+#endif
+}
+
+static unsigned getCurrentNUMANode()
+{
+#ifdef CV_HAVE_NUMA_TOPOLOGY
+    return (unsigned)NUMATopology::instance().currentNode();
+#else
+    return 0;
+#endif
+}
+
+static void bindCurrentThreadToNUMANode(unsigned node)
+{
+#ifdef CV_HAVE_NUMA_TOPOLOGY
+    const NUMATopology& topology = NUMATopology::instance();
+    if (node >= topology.node_cpus.size())
+        return;
+    int res = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &topology.node_cpus[node]);
+    if (res != 0)
+    {
+        CV_LOG_WARNING(NULL, "NUMA: can't bind thread to node " << node << ": res = " << res);
+    }
+#else
+    CV_UNUSED(node);
+#endif
+}
+
 class WorkerThread;
 class ParallelJob;
+class WSJob;
+
+struct WSTask
+{
+    WSTask() : job(NULL) {}
+    WSTask(WSJob* job_, const Range& range_) : job(job_), range(range_) {}
+
+    WSJob* job;
+    Range range;  // sub-range of job's stripes
+};
+
+// Task deque of a single thread: owner pushes/pops at the back (LIFO, cache-hot data),
+// other threads steal from the front (FIFO, largest not-yet-split ranges)
+class WSQueue
+{
+public:
+    WSQueue()
+    {
+        size.store(0, std::memory_order_relaxed);
+        dummy_[0] = 0; // compiler warning
+        int res = pthread_mutex_init(&mutex, NULL);
+        if (res != 0)
+        {
+            CV_LOG_ERROR(NULL, "Can't create task queue mutex: res = " << res);
+        }
+    }
+    ~WSQueue()
+    {
+        pthread_mutex_destroy(&mutex);
+    }
+
+    void push(const WSTask& task)
+    {
+        pthread_mutex_lock(&mutex);
+        tasks.push_back(task);
+        size.fetch_add(1, std::memory_order_seq_cst);
+        pthread_mutex_unlock(&mutex);
+    }
+
+    bool pop(WSTask& task)
+    {
+        if (size.load(std::memory_order_acquire) == 0)
+            return false;
+        pthread_mutex_lock(&mutex);
+        bool res = !tasks.empty();
+        if (res)
+        {
+            task = tasks.back();
+            tasks.pop_back();
+            size.fetch_sub(1, std::memory_order_seq_cst);
+        }
+        pthread_mutex_unlock(&mutex);
+        return res;
+    }
+
+    bool steal(WSTask& task)
+    {
+        if (size.load(std::memory_order_acquire) == 0)
+            return false;
+        pthread_mutex_lock(&mutex);
+        bool res = !tasks.empty();
+        if (res)
+        {
+            task = tasks.front();
+            tasks.pop_front();
+            size.fetch_sub(1, std::memory_order_seq_cst);
+        }
+        pthread_mutex_unlock(&mutex);
+        return res;
+    }
+
+    pthread_mutex_t mutex;
+    std::deque<WSTask> tasks;
+    std::atomic<int> size;
+    int64 dummy_[8];  // avoid cache-line sharing between queues of different threads
+};
+
+class WSJob
+{
+public:
+    WSJob(const ParallelLoopBody& body_, const Range& range_, int grain_) :
+        body(body_),
+        range(range_),
+        grain(grain_)
+    {
+        pending.store(range.size(), std::memory_order_relaxed);
+    }
+
+    const ParallelLoopBody& body;
+    const Range range;
+    const int grain;  // tasks of this size are executed without further splitting
+
+    std::atomic<int> pending;  // number of not processed stripes
+};
+
+struct WSThreadState
+{
+    WSThreadState() : queue(NULL), rng_state((unsigned)(size_t)this) {}
+
+    WSQueue* queue;  // non-NULL if thread participates in the work-stealing pool right now
+    unsigned rng_state;  // victim selection
+
+    unsigned nextVictim()
+    {
+        rng_state = rng_state * 1664525u + 1013904223u;
+        return rng_state >> 8;
+    }
+};
 
 class ThreadPool
 {
@@ -108,15 +351,27 @@ public:
 
     void run(const Range& range, const ParallelLoopBody& body, double nstripes);
 
+    // work-stealing mode
+    void run_ws(const Range& range, const ParallelLoopBody& body, double nstripes);
+    bool ws_find_task(WSThreadState& state, WSTask& task);
+    void ws_execute(WSThreadState& state, WSTask task);
+    void ws_wait(WSThreadState& state, const WSJob& job);
+    void ws_notify_one();
+    void ws_notify_all();
+    bool ws_is_nested_region();
+
     size_t getNumOfThreads();
 
     void setNumOfThreads(unsigned n);
 
+    unsigned getNUMANodeForThread(unsigned thread_idx) const;  // 0 - main thread, 1..N - worker threads
+
     ThreadPool();
 
     ~ThreadPool();
 
     unsigned num_threads;
+    unsigned numa_nodes;  // 1 if NUMA-aware mode is disabled
 
     pthread_mutex_t mutex;  // guards fields (job/threads) from non-worker threads (concurrent parallel_for calls)
 #if defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
@@ -130,6 +385,16 @@ public:
 
     Ptr<ParallelJob> job;
 
+    // work-stealing mode
+    TLSData<WSThreadState> ws_tls;
+    WSQueue ws_master_queue;  // queue of the external thread which has submitted the top-level job
+    std::atomic<bool> ws_master_busy;
+    std::atomic<int> ws_queued_tasks;  // total number of tasks in all queues
+    std::atomic<int> ws_sleeping_workers;
+    pthread_rwlock_t ws_threads_lock;  // guards `threads` from concurrent access by thieves
+    pthread_mutex_t ws_mutex;
+    pthread_cond_t ws_cond_wake;
+
 #ifdef CV_PROFILE_THREADS
     double tickFreq;
     int64 jobSubmitTime;
@@ -197,6 +462,7 @@ class WorkerThread
 public:
     ThreadPool& thread_pool;
     const unsigned id;
+    const unsigned numa_node;
     pthread_t posix_thread;
     bool is_created;
 
@@ -206,6 +472,8 @@ public:
 
     Ptr<ParallelJob> job;
 
+    WSQueue ws_queue;
+
     pthread_mutex_t mutex;
 #if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
     volatile bool isActive;
@@ -215,6 +483,7 @@ public:
     WorkerThread(ThreadPool& thread_pool_, unsigned id_) :
         thread_pool(thread_pool_),
         id(id_),
+        numa_node(thread_pool_.getNUMANodeForThread(id_ + 1)),
         posix_thread(0),
         is_created(false),
         stop_thread(false),
@@ -274,6 +543,7 @@ public:
     }
 
     void thread_body();
+    void thread_body_ws();
     static void* thread_loop_wrapper(void* thread_object)
     {
 #ifdef OPENCV_WITH_ITT
@@ -287,14 +557,28 @@ public:
 class ParallelJob
 {
 public:
+    struct NUMAPart
+    {
+        std::atomic<int> current_task;  // next free task of the node's part of job
+        int end_task;
+        int64 dummy_[8];  // avoid cache-line reusing for the same atomics
+    };
+
     ParallelJob(const ThreadPool& thread_pool_, const Range& range_, const ParallelLoopBody& body_, int nstripes_) :
         thread_pool(thread_pool_),
         body(body_),
         range(range_),
         nstripes((unsigned)nstripes_),
+        numa_parts(thread_pool_.numa_nodes > 1 ? thread_pool_.numa_nodes : 0),
         is_completed(false)
     {
         CV_LOG_VERBOSE(NULL, 5, "ParallelJob::ParallelJob(" << (void*)this << ")");
+        for (size_t k = 0; k < numa_parts.size(); k++)
+        {
+            // contiguous part of range per node
+            numa_parts[k].current_task.store((int)((int64)range.size() * k / numa_parts.size()), std::memory_order_relaxed);
+            numa_parts[k].end_task = (int)((int64)range.size() * (k + 1) / numa_parts.size());
+        }
         current_task.store(0, std::memory_order_relaxed);
         active_thread_count.store(0, std::memory_order_relaxed);
         completed_thread_count.store(0, std::memory_order_relaxed);
@@ -306,8 +590,22 @@ public:
         CV_LOG_VERBOSE(NULL, 5, "ParallelJob::~ParallelJob(" << (void*)this << ")");
     }
 
-    unsigned execute(bool is_worker_thread)
+    bool hasFreeTasks() const
+    {
+        if (numa_parts.empty())
+            return current_task < range.size();
+        for (size_t k = 0; k < numa_parts.size(); k++)
+        {
+            if (numa_parts[k].current_task < numa_parts[k].end_task)
+                return true;
+        }
+        return false;
+    }
+
+    unsigned execute(bool is_worker_thread, unsigned numa_node)
     {
+        if (!numa_parts.empty())
+            return execute_numa(is_worker_thread, numa_node);
         unsigned executed_tasks = 0;
         const int task_count = range.size();
         const int remaining_multiplier = std::min(nstripes,
@@ -340,11 +638,49 @@ public:
         return executed_tasks;
     }
 
+    // process tasks of own node first, then help other nodes
+    unsigned execute_numa(bool is_worker_thread, unsigned numa_node)
+    {
+        unsigned executed_tasks = 0;
+        const unsigned num_parts = (unsigned)numa_parts.size();
+        const int remaining_multiplier = std::max(1u, std::min(nstripes,
+                std::max(
+                        std::min(100u, thread_pool.num_threads * 4),
+                        thread_pool.num_threads * 2
+                )) / num_parts);  // experimental value
+        for (unsigned k = 0; k < num_parts; k++)
+        {
+            NUMAPart& part = numa_parts[(numa_node + k) % num_parts];
+            for (;;)
+            {
+                int chunk_size = std::max(1, (part.end_task - part.current_task) / remaining_multiplier);
+                int id = part.current_task.fetch_add(chunk_size, std::memory_order_seq_cst);
+                if (id >= part.end_task)
+                    break; // no more free tasks in this part
+
+                int start_id = id;
+                int end_id = std::min(part.end_task, id + chunk_size);
+                executed_tasks += end_id - start_id;
+                CV_LOG_VERBOSE(NULL, 9, "Thread: job " << start_id << "-" << end_id << " (node " << numa_node << ")");
+
+                body.operator()(Range(range.start + start_id, range.start + end_id));
+                if (is_worker_thread && is_completed)
+                {
+                    CV_LOG_ERROR(NULL, "\t\t\t\tBUG! Job: " << (void*)this << " " << id << " " << active_thread_count << " " << completed_thread_count);
+                    CV_Assert(!is_completed); // TODO Dbg this
+                }
+            }
+        }
+        return executed_tasks;
+    }
+
     const ThreadPool& thread_pool;
     const ParallelLoopBody& body;
     const Range range;
     const unsigned nstripes;
 
+    std::vector<NUMAPart> numa_parts;  // empty if NUMA-aware mode is disabled
+
     std::atomic<int> current_task;  // next free part of job
     int64 dummy0_[8];  // avoid cache-line reusing for the same atomics
 
@@ -375,6 +711,15 @@ void WorkerThread::thread_body()
     (void)cv::utils::getThreadID(); // notify OpenCV about new thread
     CV_LOG_VERBOSE(NULL, 5, "Thread: new thread: " << id);
 
+    if (thread_pool.numa_nodes > 1)
+        bindCurrentThreadToNUMANode(numa_node);
+
+    if (CV_THREAD_POOL_WORK_STEALING)
+    {
+        thread_body_ws();
+        return;
+    }
+
     bool allow_active_wait = true;
 
 #ifdef CV_PROFILE_THREADS
@@ -430,16 +775,16 @@ void WorkerThread::thread_body()
             if (j)
             {
                 CV_LOG_VERBOSE(NULL, 5, "Thread: job size=" << j->range.size() << " done=" << j->current_task);
-                if (j->current_task < j->range.size())
+                if (j->hasFreeTasks())
                 {
                     int other = j->active_thread_count.fetch_add(1, std::memory_order_seq_cst);
                     CV_LOG_VERBOSE(NULL, 5, "Thread: processing new job (with " << other << " other threads)"); CV_UNUSED(other);
 #ifdef CV_PROFILE_THREADS
                     stat.threadExecuteStart = getTickCount();
-                    stat.executedTasks = j->execute(true);
+                    stat.executedTasks = j->execute(true, numa_node);
                     stat.threadExecuteStop = getTickCount();
 #else
-                    j->execute(true);
+                    j->execute(true, numa_node);
 #endif
                     int completed = j->completed_thread_count.fetch_add(1, std::memory_order_seq_cst) + 1;
                     int active = j->active_thread_count.load(std::memory_order_acquire);
@@ -478,6 +823,48 @@ void WorkerThread::thread_body()
     }
 }
 
+void WorkerThread::thread_body_ws()
+{
+    WSThreadState& state = thread_pool.ws_tls.getRef();
+    state.queue = &ws_queue;
+
+    bool allow_active_wait = true;
+    while (!stop_thread)
+    {
+        WSTask task;
+        if (thread_pool.ws_find_task(state, task))
+        {
+            thread_pool.ws_execute(state, task);
+            allow_active_wait = true;
+            continue;
+        }
+        if (allow_active_wait && CV_WORKER_ACTIVE_WAIT > 0)
+        {
+            allow_active_wait = false;
+            for (int i = 0; i < CV_WORKER_ACTIVE_WAIT; i++)
+            {
+                if (thread_pool.ws_queued_tasks.load(std::memory_order_acquire) > 0 || stop_thread)
+                    break;
+                if (CV_ACTIVE_WAIT_PAUSE_LIMIT > 0 && (i < CV_ACTIVE_WAIT_PAUSE_LIMIT || (i & 1)))
+                    CV_PAUSE(16);
+                else
+                    CV_YIELD();
+            }
+            continue;
+        }
+        pthread_mutex_lock(&thread_pool.ws_mutex);
+        thread_pool.ws_sleeping_workers.fetch_add(1, std::memory_order_seq_cst);
+        while (!stop_thread && thread_pool.ws_queued_tasks.load(std::memory_order_seq_cst) == 0)
+        {
+            pthread_cond_wait(&thread_pool.ws_cond_wake, &thread_pool.ws_mutex);
+        }
+        thread_pool.ws_sleeping_workers.fetch_sub(1, std::memory_order_seq_cst);
+        pthread_mutex_unlock(&thread_pool.ws_mutex);
+        allow_active_wait = true;
+    }
+    state.queue = NULL;
+}
+
 ThreadPool::ThreadPool()
 {
 #ifdef CV_PROFILE_THREADS
@@ -492,11 +879,19 @@ ThreadPool::ThreadPool()
 #endif
     res |= pthread_cond_init(&cond_thread_task_complete, NULL);
 
+    ws_master_busy.store(false, std::memory_order_relaxed);
+    ws_queued_tasks.store(0, std::memory_order_relaxed);
+    ws_sleeping_workers.store(0, std::memory_order_relaxed);
+    res |= pthread_rwlock_init(&ws_threads_lock, NULL);
+    res |= pthread_mutex_init(&ws_mutex, NULL);
+    res |= pthread_cond_init(&ws_cond_wake, NULL);
+
     if (0 != res)
     {
         CV_LOG_FATAL(NULL, "Failed to initialize ThreadPool (pthreads)");
     }
     num_threads = defaultNumberOfThreads();
+    numa_nodes = CV_THREAD_POOL_NUMA ? getNUMANodesCount() : 1;
 }
 
 bool ThreadPool::reconfigure_(unsigned new_threads_count)
@@ -508,6 +903,7 @@ bool ThreadPool::reconfigure_(unsigned new_threads_count)
     {
         CV_LOG_VERBOSE(NULL, 1, "MainThread: reduce worker pool: " << threads.size() << " => " << new_threads_count);
         std::vector< Ptr<WorkerThread> > release_threads(threads.size() - new_threads_count);
+        pthread_rwlock_wrlock(&ws_threads_lock);
         for (size_t i = new_threads_count; i < threads.size(); ++i)
         {
             pthread_mutex_lock(&threads[i]->mutex);  // to avoid signal miss due pre-check
@@ -526,16 +922,21 @@ bool ThreadPool::reconfigure_(unsigned new_threads_count)
         pthread_cond_broadcast(&cond_thread_wake); // wake all threads
 #endif
         threads.resize(new_threads_count);
+        pthread_rwlock_unlock(&ws_threads_lock);
+        if (CV_THREAD_POOL_WORK_STEALING)
+            ws_notify_all();
         release_threads.clear();  // calls thread_join which want to lock mutex
         return false;
     }
     else
     {
         CV_LOG_VERBOSE(NULL, 1, "MainThread: upgrade worker pool: " << threads.size() << " => " << new_threads_count);
+        pthread_rwlock_wrlock(&ws_threads_lock);
         for (size_t i = threads.size(); i < new_threads_count; ++i)
         {
             threads.push_back(Ptr<WorkerThread>(new WorkerThread(*this, (unsigned)i))); // spawn more threads
         }
+        pthread_rwlock_unlock(&ws_threads_lock);
     }
     return false;
 }
@@ -549,6 +950,9 @@ ThreadPool::~ThreadPool()
 #endif
     pthread_mutex_destroy(&mutex);
     pthread_mutex_destroy(&mutex_notify);
+    pthread_cond_destroy(&ws_cond_wake);
+    pthread_mutex_destroy(&ws_mutex);
+    pthread_rwlock_destroy(&ws_threads_lock);
 }
 
 void ThreadPool::run(const Range& range, const ParallelLoopBody& body, double nstripes)
@@ -560,6 +964,11 @@ void ThreadPool::run(const Range& range, const ParallelLoopBody& body, double ns
     threads_stat[0].threadWait = jobSubmitTime;
     threads_stat[0].threadWake = jobSubmitTime;
 #endif
+    if (CV_THREAD_POOL_WORK_STEALING)
+    {
+        run_ws(range, body, nstripes);
+        return;
+    }
     if (getNumOfThreads() > 1 &&
         job == NULL &&
         (range.size() * nstripes >= 2 || (range.size() > 1 && nstripes <= 0))
@@ -583,7 +992,7 @@ void ThreadPool::run(const Range& range, const ParallelLoopBody& body, double ns
             size_t num_threads_to_wake = std::min(static_cast<size_t>(range.size()), threads.size());
             for (size_t i = 0; i < num_threads_to_wake; ++i)
             {
-                if (job->current_task >= job->range.size())
+                if (!job->hasFreeTasks())
                     break;
                 WorkerThread& thread = *(threads[i].get());
                 if (
@@ -642,14 +1051,15 @@ void ThreadPool::run(const Range& range, const ParallelLoopBody& body, double ns
 
             {
                 ParallelJob& j = *(this->job);
+                const unsigned main_numa_node = numa_nodes > 1 ? getCurrentNUMANode() : 0;
 #ifdef CV_PROFILE_THREADS
                 threads_stat[0].threadExecuteStart = getTickCount();
-                threads_stat[0].executedTasks = j.execute(false);
+                threads_stat[0].executedTasks = j.execute(false, main_numa_node);
                 threads_stat[0].threadExecuteStop = getTickCount();
 #else
-                j.execute(false);
+                j.execute(false, main_numa_node);
 #endif
-                CV_Assert(j.current_task >= j.range.size());
+                CV_Assert(!j.hasFreeTasks());
                 CV_LOG_VERBOSE(NULL, 5, "MainThread: complete self-tasks: " << j.active_thread_count << " " << j.completed_thread_count);
                 if (job->is_completed || j.active_thread_count == 0)
                 {
@@ -716,18 +1126,168 @@ void ThreadPool::run(const Range& range, const ParallelLoopBody& body, double ns
     }
 }
 
+void ThreadPool::run_ws(const Range& range, const ParallelLoopBody& body, double nstripes)
+{
+    if (getNumOfThreads() <= 1 ||
+        !(range.size() * nstripes >= 2 || (range.size() > 1 && nstripes <= 0)))
+    {
+        body(range);
+        return;
+    }
+
+    WSThreadState& state = ws_tls.getRef();
+    const bool is_nested = state.queue != NULL;  // called from the body of the other job
+    if (!is_nested)
+    {
+        if (ws_master_busy.exchange(true, std::memory_order_acq_rel))
+        {
+            body(range);  // pool is owned by the other external thread
+            return;
+        }
+        pthread_mutex_lock(&mutex);
+        reconfigure_(num_threads - 1);
+        pthread_mutex_unlock(&mutex);
+        state.queue = &ws_master_queue;
+    }
+    CV_LOG_VERBOSE(NULL, 1, "Thread: new work-stealing job: nested=" << is_nested << "   range=" << range.size() << "   nstripes=" << nstripes);
+
+    const int max_parts = (int)std::max(std::min(100u, num_threads * 4), num_threads * 2);  // experimental value
+    WSJob j(body, range, std::max(1, range.size() / max_parts));
+    ws_execute(state, WSTask(&j, range));
+    ws_wait(state, j);
+
+    if (!is_nested)
+    {
+        state.queue = NULL;
+        ws_master_busy.store(false, std::memory_order_release);
+    }
+}
+
+bool ThreadPool::ws_find_task(WSThreadState& state, WSTask& task)
+{
+    if (state.queue->pop(task))
+    {
+        ws_queued_tasks.fetch_sub(1, std::memory_order_seq_cst);
+        return true;
+    }
+    if (ws_queued_tasks.load(std::memory_order_acquire) == 0)
+        return false;
+
+    bool found = false;
+    pthread_rwlock_rdlock(&ws_threads_lock);
+    const unsigned num_queues = (unsigned)threads.size() + 1;
+    const unsigned start = state.nextVictim() % num_queues;
+    for (unsigned i = 0; i < num_queues && !found; ++i)
+    {
+        unsigned victim = (start + i) % num_queues;
+        WSQueue& q = victim == 0 ? ws_master_queue : threads[victim - 1]->ws_queue;
+        if (&q != state.queue)
+            found = q.steal(task);
+    }
+    pthread_rwlock_unlock(&ws_threads_lock);
+    if (found)
+        ws_queued_tasks.fetch_sub(1, std::memory_order_seq_cst);
+    return found;
+}
+
+void ThreadPool::ws_execute(WSThreadState& state, WSTask task)
+{
+    WSJob& j = *task.job;
+    // binary splitting: keep the first half, publish the second one for the idle threads
+    while (task.range.size() > j.grain)
+    {
+        int mid = task.range.start + task.range.size() / 2;
+        state.queue->push(WSTask(task.job, Range(mid, task.range.end)));
+        ws_queued_tasks.fetch_add(1, std::memory_order_seq_cst);
+        ws_notify_one();
+        task.range.end = mid;
+    }
+    CV_LOG_VERBOSE(NULL, 9, "Thread: job " << task.range.start << "-" << task.range.end);
+    j.body(task.range);
+
+    const int n = task.range.size();
+    if (j.pending.fetch_sub(n, std::memory_order_acq_rel) == n)
+    {
+        // job may be destroyed by the waiting thread since this point
+        pthread_mutex_lock(&mutex_notify);  // to avoid signal miss due pre-check condition
+        // empty
+        pthread_mutex_unlock(&mutex_notify);
+        pthread_cond_broadcast(&cond_thread_task_complete);
+    }
+}
+
+void ThreadPool::ws_wait(WSThreadState& state, const WSJob& j)
+{
+    // help other threads while the job is not completed
+    int i = 0;
+    while (j.pending.load(std::memory_order_acquire) > 0)
+    {
+        WSTask task;
+        if (ws_find_task(state, task))
+        {
+            ws_execute(state, task);
+            i = 0;
+            continue;
+        }
+        if (i++ < CV_MAIN_THREAD_ACTIVE_WAIT)
+        {
+            if (CV_ACTIVE_WAIT_PAUSE_LIMIT > 0 && (i < CV_ACTIVE_WAIT_PAUSE_LIMIT || (i & 1)))
+                CV_PAUSE(16);
+            else
+                CV_YIELD();
+            continue;
+        }
+        // remaining tasks are processed by other threads
+        pthread_mutex_lock(&mutex_notify);
+        while (j.pending.load(std::memory_order_acquire) > 0)
+        {
+            pthread_cond_wait(&cond_thread_task_complete, &mutex_notify);
+        }
+        pthread_mutex_unlock(&mutex_notify);
+    }
+}
+
+void ThreadPool::ws_notify_one()
+{
+    if (ws_sleeping_workers.load(std::memory_order_seq_cst) == 0)
+        return;
+    pthread_mutex_lock(&ws_mutex);  // to avoid signal miss due pre-check condition
+    pthread_mutex_unlock(&ws_mutex);
+    pthread_cond_signal(&ws_cond_wake);
+}
+
+void ThreadPool::ws_notify_all()
+{
+    pthread_mutex_lock(&ws_mutex);
+    pthread_mutex_unlock(&ws_mutex);
+    pthread_cond_broadcast(&ws_cond_wake);
+}
+
+bool ThreadPool::ws_is_nested_region()
+{
+    return CV_THREAD_POOL_WORK_STEALING && ws_tls.getRef().queue != NULL;
+}
+
 size_t ThreadPool::getNumOfThreads()
 {
     return num_threads;
 }
 
+unsigned ThreadPool::getNUMANodeForThread(unsigned thread_idx) const
+{
+    if (numa_nodes <= 1)
+        return 0;
+    // contiguous groups of threads per node (the same order as parts of job range)
+    return (unsigned)((uint64)thread_idx * numa_nodes / std::max(num_threads, thread_idx + 1));
+}
+
 void ThreadPool::setNumOfThreads(unsigned n)
 {
     if (n != num_threads)
     {
         num_threads = n;
         if (n == 1)
-           if (job == NULL) reconfigure(0);  // stop worker threads immediately
+           if (job == NULL && !ws_master_busy) reconfigure(0);  // stop worker threads immediately
     }
 }
 
@@ -753,6 +1313,21 @@ void parallel_for_pthreads(const Range& range, const ParallelLoopBody& body, dou
     ThreadPool::instance().run(range, body, nstripes);
 }
 
+bool parallel_pthreads_numa_first_touch_required(size_t size)
+{
+    if (!CV_THREAD_POOL_NUMA || size < CV_THREAD_POOL_NUMA_FIRST_TOUCH_THRESHOLD)
+        return false;
+    ThreadPool& pool = ThreadPool::instance();
+    return pool.numa_nodes > 1 && pool.getNumOfThreads() > 1;
+}
+
+bool parallel_pthreads_is_nested_region()
+{
+    if (!CV_THREAD_POOL_WORK_STEALING)
+        return false;
+    return ThreadPool::instance().ws_is_nested_region();
+}
+
 }
 
 #endif
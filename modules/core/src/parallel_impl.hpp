@@ -7,10 +7,15 @@
 namespace cv {
 
 unsigned defaultNumberOfThreads();
+bool isNUMAFirstTouchRequired(size_t size);
 
 void parallel_for_pthreads(const Range& range, const ParallelLoopBody& body, double nstripes);
 size_t parallel_pthreads_get_threads_num();
 void parallel_pthreads_set_threads_num(int num);
+/// true if NUMA-aware mode is enabled and buffer pages should be touched by threads which process them
+bool parallel_pthreads_numa_first_touch_required(size_t size);
+/// true if called from the body of parallel job running by work-stealing thread pool (nested jobs are allowed)
+bool parallel_pthreads_is_nested_region();
 
 }
 
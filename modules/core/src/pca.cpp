@@ -50,18 +50,103 @@
 namespace cv
 {
 
-PCA::PCA() {}
+PCA::PCA() : nsamples(0) {}
 
-PCA::PCA(InputArray data, InputArray _mean, int flags, int maxComponents)
+PCA::PCA(InputArray data, InputArray _mean, int flags, int maxComponents) : nsamples(0)
 {
     operator()(data, _mean, flags, maxComponents);
 }
 
-PCA::PCA(InputArray data, InputArray _mean, int flags, double retainedVariance)
+PCA::PCA(InputArray data, InputArray _mean, int flags, double retainedVariance) : nsamples(0)
 {
     operator()(data, _mean, flags, retainedVariance);
 }
 
+// number of extra random projections and power iterations of the randomized PCA
+static const int PCA_RANDOMIZED_OVERSAMPLING = 10;
+static const int PCA_RANDOMIZED_POWER_ITERATIONS = 2;
+
+// modified Gram-Schmidt orthonormalization of the matrix rows, degenerate rows are zeroed
+static void orthonormalizeRows(Mat& q)
+{
+    for( int i = 0; i < q.rows; i++ )
+    {
+        Mat qi = q.row(i);
+        double norm0 = norm(qi);
+        for( int j = 0; j < i; j++ )
+        {
+            Mat qj = q.row(j);
+            scaleAdd(qj, -qi.dot(qj), qi, qi);
+        }
+        double nrm = norm(qi);
+        if( nrm > norm0*FLT_EPSILON )
+            qi *= 1./nrm;
+        else
+            qi = Scalar(0);
+    }
+}
+
+/*
+Randomized truncated SVD of the centered data (N. Halko, P. G. Martinsson, J. A. Tropp (2011)
+Finding structure with randomness). The data is accessed only via matrix products, the mean is
+subtracted from the products, so neither the centered copy of the data nor the covariance matrix
+are formed.
+*/
+static void randomizedPCA( const Mat& _data, bool asCol, const Mat& mean, int maxComponents,
+                           Mat& eigenvalues, Mat& eigenvectors )
+{
+    const int ctype = mean.type();
+    const int len = asCol ? _data.rows : _data.cols, in_count = asCol ? _data.cols : _data.rows;
+    const int l = std::min(maxComponents + PCA_RANDOMIZED_OVERSAMPLING, std::min(len, in_count));
+
+    Mat data = _data;
+    if( data.type() != ctype )
+        _data.convertTo(data, ctype);
+    Mat avg = mean.reshape(1, 1);
+
+    // y = w*A', A is the centered data with samples stored as rows
+    auto projectToSamples = [&](const Mat& w, Mat& y)
+    {
+        gemm(w, data, 1, noArray(), 0, y, asCol ? 0 : GEMM_2_T);
+        Mat wm;
+        Mat(w*avg.t()).convertTo(wm, CV_64F);
+        for( int i = 0; i < y.rows; i++ )
+            y.row(i) -= Scalar(wm.at<double>(i));
+    };
+    // z = y*A
+    auto projectToFeatures = [&](const Mat& y, Mat& z)
+    {
+        gemm(y, data, 1, noArray(), 0, z, asCol ? GEMM_2_T : 0);
+        Mat s;
+        reduce(y, s, 1, REDUCE_SUM, CV_64F);
+        for( int i = 0; i < z.rows; i++ )
+        {
+            Mat zi = z.row(i);
+            scaleAdd(avg, -s.at<double>(i), zi, zi);
+        }
+    };
+
+    RNG rng(0x12345678);
+    Mat omega(l, len, ctype), q, z;
+    rng.fill(omega, RNG::NORMAL, 0, 1);
+
+    projectToSamples(omega, q);
+    orthonormalizeRows(q);
+    for( int i = 0; i < PCA_RANDOMIZED_POWER_ITERATIONS; i++ )
+    {
+        projectToFeatures(q, z);
+        orthonormalizeRows(z);
+        projectToSamples(z, q);
+        orthonormalizeRows(q);
+    }
+    projectToFeatures(q, z);
+
+    SVD svd(z);
+    eigenvectors = svd.vt.rowRange(0, maxComponents).clone();
+    Mat w = svd.w.rowRange(0, maxComponents);
+    multiply(w, w, eigenvalues, 1./in_count);
+}
+
 PCA& PCA::operator()(InputArray _data, InputArray __mean, int flags, int maxComponents)
 {
     Mat data = _data.getMat(), _mean = __mean.getMat();
@@ -96,8 +181,7 @@ PCA& PCA::operator()(InputArray _data, InputArray __mean, int flags, int maxComp
 
     int ctype = std::max(CV_32F, data.depth());
     mean.create( mean_sz, ctype );
-
-    Mat covar( count, count, ctype );
+    nsamples = in_count;
 
     if( !_mean.empty() )
     {
@@ -106,6 +190,16 @@ PCA& PCA::operator()(InputArray _data, InputArray __mean, int flags, int maxComp
         covar_flags |= CV_COVAR_USE_AVG;
     }
 
+    if( (flags & RANDOMIZED) && maxComponents > 0 && out_count + PCA_RANDOMIZED_OVERSAMPLING < count )
+    {
+        if( _mean.empty() )
+            reduce( data, mean, (flags & CV_PCA_DATA_AS_COL) ? 1 : 0, REDUCE_AVG, ctype );
+        randomizedPCA( data, (flags & CV_PCA_DATA_AS_COL) != 0, mean, out_count, eigenvalues, eigenvectors );
+        return *this;
+    }
+
+    Mat covar( count, count, ctype );
+
     calcCovarMatrix( data, covar, mean, covar_flags, ctype );
     eigen( covar, eigenvalues, eigenvectors );
 
@@ -156,6 +250,7 @@ void PCA::write(FileStorage& fs ) const
     fs << "vectors" << eigenvectors;
     fs << "values" << eigenvalues;
     fs << "mean" << mean;
+    fs << "samples" << (double)nsamples;
 }
 
 void PCA::read(const FileNode& fn)
@@ -166,6 +261,9 @@ void PCA::read(const FileNode& fn)
     cv::read(fn["vectors"], eigenvectors);
     cv::read(fn["values"], eigenvalues);
     cv::read(fn["mean"], mean);
+    double samples;
+    cv::read(fn["samples"], samples, 0.);
+    nsamples = (int64)samples;
 }
 
 template <typename T>
@@ -224,6 +322,7 @@ PCA& PCA::operator()(InputArray _data, InputArray __mean, int flags, double reta
     CV_Assert( retainedVariance > 0 && retainedVariance <= 1 );
 
     int count = std::min(len, in_count);
+    nsamples = in_count;
 
     // "scrambled" way to compute PCA (when cols(A)>rows(A)):
     // B = A'A; B*x=b*x; C = AA'; C*y=c*y -> AA'*y=c*y -> A'A*(A'*y)=c*(A'*y) -> c = b, x=A'*y
@@ -289,6 +388,68 @@ PCA& PCA::operator()(InputArray _data, InputArray __mean, int flags, double reta
     return *this;
 }
 
+PCA& PCA::update(InputArray _data, int flags, int maxComponents)
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat data = _data.getMat();
+    CV_Assert( data.channels() == 1 );
+    if( eigenvectors.empty() )
+    {
+        operator()(data, noArray(), flags, maxComponents);
+        return *this;
+    }
+
+    const bool asCol = (flags & DATA_AS_COL) != 0;
+    const int ctype = mean.type();
+    const int len = eigenvectors.cols, k = eigenvectors.rows;
+    CV_Assert( nsamples > 0 && mean.total() == (size_t)len && (mean.rows == 1) == !asCol );
+    CV_Assert( (asCol ? data.rows : data.cols) == len );
+
+    // the batch with samples stored as rows
+    Mat batch;
+    if( asCol )
+        transpose(data, batch);
+    else
+        batch = data;
+    if( batch.type() != ctype )
+        batch.convertTo(batch, ctype);
+    const int m = batch.rows;
+    if( m == 0 )
+        return *this;
+
+    Mat batchMean, avg = mean.reshape(1, 1);
+    reduce(batch, batchMean, 0, REDUCE_AVG);
+
+    // [ diag(s)*V; batch - batchMean; sqrt(n*m/(n+m))*(mean - batchMean) ],
+    // where s are the singular values of the data seen so far, s^2 = eigenvalues*n
+    const double n = (double)nsamples;
+    Mat A(k + m + 1, len, ctype), evals;
+    eigenvalues.convertTo(evals, CV_64F);
+    for( int i = 0; i < k; i++ )
+    {
+        double s = std::sqrt(std::max(evals.at<double>(i), 0.)*n);
+        eigenvectors.row(i).convertTo(A.row(i), ctype, s);
+    }
+    subtract(batch, repeat(batchMean, m, 1), A.rowRange(k, k + m));
+    subtract(avg, batchMean, A.row(k + m));
+    A.row(k + m) *= std::sqrt(n*m/(n + m));
+
+    SVD svd(A, SVD::MODIFY_A);
+
+    int out_count = maxComponents > 0 ? maxComponents : k;
+    out_count = std::min(out_count, svd.vt.rows);
+    eigenvectors = svd.vt.rowRange(0, out_count).clone();
+    Mat w = svd.w.rowRange(0, out_count);
+    multiply(w, w, eigenvalues, 1./(n + m));
+
+    Mat newMean;
+    addWeighted(avg, n/(n + m), batchMean, m/(n + m), 0, newMean);
+    mean = newMean.reshape(1, mean.rows);
+    nsamples += m;
+    return *this;
+}
+
 void PCA::project(InputArray _data, OutputArray result) const
 {
     Mat data = _data.getMat();
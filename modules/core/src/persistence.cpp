@@ -11,6 +11,12 @@
 
 #include <opencv2/core/utils/logger.hpp>
 
+#if defined __unix__ || defined __APPLE__
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define CV_FS_HAVE_MMAP 1
+#endif
+
 namespace cv
 {
 
@@ -405,6 +411,13 @@ void FileStorage::Impl::init() {
     strbufsize = strbufpos = 0;
     roots.clear();
 
+    lazy_payloads.clear();
+    mapped_data = 0;
+    mapped_size = 0;
+
+    binary_emitter.release();
+    binary_data.release();
+
     fs_data.clear();
     fs_data_ptrs.clear();
     fs_data_blksz.clear();
@@ -441,6 +454,8 @@ void FileStorage::Impl::release(String *out) {
                 puts("</opencv_storage>\n");
             else if (fmt == FileStorage::FORMAT_JSON)
                 puts("}\n");
+            else if (fmt == FileStorage::FORMAT_BINARY)
+                binary_emitter->finish();
         }
         if (mem_mode && out) {
             *out = cv::String(outbuf.begin(), outbuf.end());
@@ -509,6 +524,10 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
 
     flags = _flags;
 
+    bool binary = write_mode && (flags & FileStorage::FORMAT_MASK) == FileStorage::FORMAT_BINARY;
+    if (binary && (mem_mode || append))
+        CV_Error(cv::Error::StsNotImplemented, "FileStorage::FORMAT_BINARY supports writing to files only");
+
     if (!mem_mode) {
         char *dot_pos = strrchr((char *) filename.c_str(), '.');
         char compression = '\0';
@@ -518,6 +537,9 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
             if (append) {
                 CV_Error(cv::Error::StsNotImplemented, "Appending data to compressed file is not implemented");
             }
+            if (binary) {
+                CV_Error(cv::Error::StsNotImplemented, "Compressed FileStorage::FORMAT_BINARY files are not supported");
+            }
             isGZ = true;
             compression = dot_pos[3];
             if (compression)
@@ -525,7 +547,7 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
         }
 
         if (!isGZ) {
-            file = fopen(filename.c_str(), !write_mode ? "rt" : !append ? "wt" : "a+t");
+            file = fopen(filename.c_str(), !write_mode ? "rt" : binary ? "w+b" : !append ? "wt" : "a+t");
             if (!file)
             {
                 CV_LOG_ERROR(NULL, "Can't open file: '" << filename << "' in " << (!write_mode ? "read" : !append ? "write" : "append") << " mode");
@@ -597,7 +619,7 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
         buffer.reserve(buf_size + 1024);
         buffer.resize(buf_size);
         bufofs = 0;
-        is_using_base64 = write_base64;
+        is_using_base64 = write_base64 && !binary;
         state_of_writing_base64 = FileStorage_API::Base64State::Uncertain;
 
         if (fmt == FileStorage::FORMAT_XML) {
@@ -660,6 +682,9 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
                 puts("...\n---\n");
 
             emitter_do_not_use_direct_dereference = createYAMLEmitter(this);
+        } else if (fmt == FileStorage::FORMAT_BINARY) {
+            binary_emitter = createBinaryEmitter(this);
+            emitter_do_not_use_direct_dereference = binary_emitter;
         } else {
             CV_Assert(fmt == FileStorage::FORMAT_JSON);
             if (!append)
@@ -693,12 +718,20 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
         }
         is_opened = true;
     } else {
+        if (!mem_mode && file && readBinary()) {
+            closeFile();
+            is_opened = true;
+            return true;
+        }
+
         const size_t buf_size0 = 40;
         buffer.resize(buf_size0);
         if (mem_mode) {
             strbuf = (char *) filename_or_buf;
             strbufsize = strlen(strbuf);
         }
+        else if ((flags & FileStorage::LAZY) != 0 && file)
+            mapFile();
 
         const char *yaml_signature = "%YAML";
         const char *json_signature = "{";
@@ -887,7 +920,33 @@ void FileStorage::Impl::setEof() {
     dummy_eof = true;
 }
 
+void FileStorage::Impl::mapFile() {
+#ifdef CV_FS_HAVE_MMAP
+    struct stat st;
+    if (fstat(fileno(file), &st) != 0 || st.st_size <= 0)
+        return;
+    size_t size = (size_t) st.st_size;
+    void *ptr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    if (ptr == MAP_FAILED)
+        return;
+#ifdef MADV_SEQUENTIAL
+    (void) madvise(ptr, size, MADV_SEQUENTIAL);  // hint, errors are not critical
+#endif
+    mapped_data = ptr;
+    mapped_size = size;
+    // the mapping is parsed in the same way as FileStorage::MEMORY buffers
+    strbuf = (char *) ptr;
+    strbufsize = size;
+#endif
+}
+
 void FileStorage::Impl::closeFile() {
+#ifdef CV_FS_HAVE_MMAP
+    if (mapped_data)
+        munmap(mapped_data, mapped_size);
+#endif
+    mapped_data = 0;
+    mapped_size = 0;
     if (file)
         fclose(file);
 #if USE_ZLIB
@@ -1000,6 +1059,12 @@ void FileStorage::Impl::startWriteStruct_helper(const char *key, int struct_flag
 
 void FileStorage::Impl::startWriteStruct(const char *key, int struct_flags,
                                          const char *type_name) {
+    if (binary_emitter) {
+        // raw data is stored as is, there is no Base64 mode
+        startWriteStruct_helper(key, struct_flags, type_name);
+        return;
+    }
+
     check_if_write_struct_is_delayed(false);
     if (state_of_writing_base64 == FileStorage_API::NotUse)
         switch_to_Base64_state(FileStorage_API::Uncertain);
@@ -1069,6 +1134,11 @@ void FileStorage::Impl::write(const String &key, const String &value) {
 void FileStorage::Impl::writeRawData(const std::string &dt, const void *_data, size_t len) {
     CV_Assert(write_mode);
 
+    if (binary_emitter) {
+        binary_emitter->writeRawData(dt.c_str(), _data, len);
+        return;
+    }
+
     if (is_using_base64 || state_of_writing_base64 == FileStorage_API::Base64State::InUse) {
         writeRawDataBase64(_data, len, dt.c_str());
         return;
@@ -1571,7 +1641,7 @@ FileNode FileStorage::Impl::addNode(FileNode &collection, const std::string &key
 
     if (elem_type == FileNode::SEQ || elem_type == FileNode::MAP) {
         writeInt(ptr, 4);
-        writeInt(ptr, 0);
+        writeInt(ptr + 4, 0);
     }
 
     if (value)
@@ -1627,10 +1697,40 @@ int FileStorage::Impl::get_space() {
 }
 
 
+// decodes 'count' bytes starting from the byte 'byteofs' of Base64 text (without separators)
+static void decodeBase64Range(const char *src, size_t byteofs, uchar *dst, size_t count) {
+    const uchar *usrc = (const uchar *) src + byteofs / 3 * 4;
+    uchar buf[3];
+    size_t skip = byteofs % 3;
+
+    if (skip > 0 && count > 0) {
+        base64::base64_decode_quads(usrc, buf, 1);
+        size_t n = std::min(3 - skip, count);
+        memcpy(dst, buf + skip, n);
+        dst += n;
+        count -= n;
+        usrc += 4;
+    }
+
+    base64::base64_decode_quads(usrc, dst, count / 3);
+    usrc += count / 3 * 4;
+    dst += count / 3 * 3;
+    count %= 3;
+
+    if (count > 0) {
+        base64::base64_decode_quads(usrc, buf, 1);
+        memcpy(dst, buf, count);
+    }
+}
+
 FileStorage::Impl::Base64Decoder::Base64Decoder() {
     ofs = 0;
     ptr = 0;
     indent = 0;
+    text = 0;
+    textlen = 0;
+    raw = 0;
+    rawlen = 0;
     totalchars = 0;
     eos = true;
 }
@@ -1639,6 +1739,10 @@ void FileStorage::Impl::Base64Decoder::init(const Ptr<FileStorageParser> &_parse
     parser_do_not_use_direct_dereference = _parser;
     ptr = _ptr;
     indent = _indent;
+    text = 0;
+    textlen = 0;
+    raw = 0;
+    rawlen = 0;
     encoded.clear();
     decoded.clear();
     ofs = 0;
@@ -1646,27 +1750,37 @@ void FileStorage::Impl::Base64Decoder::init(const Ptr<FileStorageParser> &_parse
     eos = false;
 }
 
-bool FileStorage::Impl::Base64Decoder::readMore(int needed) {
-    static const uchar base64tab[] =
-            {
-                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 62, 0, 0, 0, 63,
-                    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 0, 0, 0, 0, 0, 0,
-                    0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
-                    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 0, 0, 0, 0, 0,
-                    0, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
-                    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 0, 0, 0, 0, 0,
-                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
-            };
+void FileStorage::Impl::Base64Decoder::init(const char *_text, size_t _textlen) {
+    parser_do_not_use_direct_dereference.release();
+    ptr = 0;
+    indent = 0;
+    text = _text;
+    textlen = _textlen;
+    raw = 0;
+    rawlen = 0;
+    encoded.clear();
+    decoded.clear();
+    ofs = 0;
+    totalchars = 0;
+    eos = false;
+}
 
+void FileStorage::Impl::Base64Decoder::init(const uchar *_raw, size_t _rawlen) {
+    parser_do_not_use_direct_dereference.release();
+    ptr = 0;
+    indent = 0;
+    text = 0;
+    textlen = 0;
+    raw = _raw;
+    rawlen = _rawlen;
+    encoded.clear();
+    decoded.clear();
+    ofs = 0;
+    totalchars = 0;
+    eos = false;
+}
+
+bool FileStorage::Impl::Base64Decoder::readMore(int needed) {
     if (eos)
         return false;
 
@@ -1679,14 +1793,34 @@ bool FileStorage::Impl::Base64Decoder::readMore(int needed) {
     decoded.resize(sz);
     ofs = 0;
 
-    CV_Assert(ptr);
-    char *beg = 0, *end = 0;
-    bool ok = getParser().getBase64Row(ptr, indent, beg, end);
-    ptr = end;
-    std::copy(beg, end, std::back_inserter(encoded));
-    totalchars += end - beg;
+    if (raw) {
+        size_t n = std::min(rawlen, (size_t) PARSER_BASE64_BUFFER_SIZE);
+        decoded.insert(decoded.end(), raw, raw + n);
+        raw += n;
+        rawlen -= n;
+        eos = n == 0;
+        return (int) decoded.size() >= needed;
+    }
+
+    bool ok = true;
+    size_t nchars = 0;
+    if (text) {
+        // in-memory text is decoded by blocks to limit the size of temporary buffers
+        nchars = std::min(textlen, (size_t) PARSER_BASE64_BUFFER_SIZE);
+        std::copy(text, text + nchars, std::back_inserter(encoded));
+        text += nchars;
+        textlen -= nchars;
+    } else {
+        CV_Assert(ptr);
+        char *beg = 0, *end = 0;
+        ok = getParser().getBase64Row(ptr, indent, beg, end);
+        ptr = end;
+        std::copy(beg, end, std::back_inserter(encoded));
+        nchars = end - beg;
+    }
+    totalchars += nchars;
 
-    if (!ok || beg == end) {
+    if (!ok || nchars == 0) {
         // in the end of base64 sequence pad it with '=' characters so that
         // its total length is multiple of
         eos = true;
@@ -1696,19 +1830,12 @@ bool FileStorage::Impl::Base64Decoder::readMore(int needed) {
     }
 
     int i = 0, j, n = (int) encoded.size();
-    if (n > 0) {
-        const uchar *tab = base64tab;
-        char *src = &encoded[0];
-
-        for (; i <= n - 4; i += 4) {
-            // dddddd cccccc bbbbbb aaaaaa => ddddddcc ccccbbbb bbaaaaaa
-            uchar d = tab[(int) (uchar) src[i]], c = tab[(int) (uchar) src[i + 1]];
-            uchar b = tab[(int) (uchar) src[i + 2]], a = tab[(int) (uchar) src[i + 3]];
-
-            decoded.push_back((uchar) ((d << 2) | (c >> 4)));
-            decoded.push_back((uchar) ((c << 4) | (b >> 2)));
-            decoded.push_back((uchar) ((b << 6) | a));
-        }
+    if (n >= 4) {
+        size_t nquads = (size_t) n / 4;
+        sz = decoded.size();
+        decoded.resize(sz + nquads * 3);
+        base64::base64_decode_quads((const uchar *) &encoded[0], &decoded[sz], nquads);
+        i = (int) nquads * 4;
     }
 
     if (i > 0 && encoded[i - 1] == '=') {
@@ -1766,9 +1893,99 @@ char *FileStorage::Impl::Base64Decoder::getPtr() const { return ptr; }
 
 
 char *FileStorage::Impl::parseBase64(char *ptr, int indent, FileNode &collection) {
+    if ((flags & FileStorage::LAZY) == 0) {
+        base64decoder.init(parser_do_not_use_direct_dereference, ptr, indent);
+        parseBase64Collection(collection);
+        return base64decoder.getPtr();
+    }
+
+    // collect the whole payload, large payloads are decoded on demand
+    LazyBase64Payload payload;
+    payload.raw = 0;
+    std::string &text = payload.text;
+    for (;;) {
+        char *beg = 0, *end = 0;
+        bool ok = getParser().getBase64Row(ptr, indent, beg, end);
+        ptr = end;
+        text.append(beg, end);
+        if (!ok || beg == end)
+            break;
+    }
+    for (; text.size() % 4 != 0;)
+        text.push_back('=');
+
+    if (text.size() < CV_FS_LAZY_BASE64_MIN_LEN) {
+        base64decoder.init(text.c_str(), text.size());
+        parseBase64Collection(collection);
+        return ptr;
+    }
+
+    uchar header[::base64::HEADER_SIZE];
+    decodeBase64Range(text.c_str(), 0, header, sizeof(header));
+    size_t npadding = text[text.size() - 1] != '=' ? 0 : text[text.size() - 2] != '=' ? 1 : 2;
+    initLazyPayload(payload, header, text.size() / 4 * 3 - npadding);
+    makeLazyNode(collection, payload.nelems, lazy_payloads.size());
+    lazy_payloads.push_back(std::move(payload));
+    return ptr;
+}
+
+void FileStorage::Impl::initLazyPayload(LazyBase64Payload &payload, const uchar *header, size_t nbytes) {
+    const int BASE64_HDR_SIZE = ::base64::HEADER_SIZE;
+    char dt[BASE64_HDR_SIZE + 1] = {0};
+    memcpy(dt, header, BASE64_HDR_SIZE);
+    int i, k;
+    for (i = 0; i < BASE64_HDR_SIZE; i++)
+        if (isspace(dt[i]))
+            break;
+    dt[i] = '\0';
+
+    int fmt_pairs[CV_FS_MAX_FMT_PAIRS * 2];
+    int fmt_pair_count = fs::decodeFormat(dt, fmt_pairs, CV_FS_MAX_FMT_PAIRS);
+    size_t struct_size = 0, struct_elems = 0;
+    payload.depth = fmt_pairs[1];
+    for (k = 0; k < fmt_pair_count; k++) {
+        struct_size += (size_t) fmt_pairs[k * 2] * CV_ELEM_SIZE(fmt_pairs[k * 2 + 1]);
+        struct_elems += fmt_pairs[k * 2];
+        if (fmt_pairs[k * 2 + 1] != payload.depth)
+            payload.depth = -1;
+    }
+
+    payload.nbytes = nbytes;
+    CV_Assert(payload.nbytes > (size_t) BASE64_HDR_SIZE && struct_size > 0);
+
+    // the same number of elements as parseBase64Collection() creates: only complete elements are stored
+    size_t data_size = payload.nbytes - BASE64_HDR_SIZE;
+    size_t rest = data_size % struct_size;
+    payload.nelems = data_size / struct_size * struct_elems;
+    for (k = 0; k < fmt_pair_count; k++) {
+        size_t elem_size = CV_ELEM_SIZE(fmt_pairs[k * 2 + 1]);
+        for (i = 0; i < fmt_pairs[k * 2] && rest >= elem_size; i++, rest -= elem_size)
+            payload.nelems++;
+    }
+    CV_Assert(payload.nelems < (size_t) INT_MAX);
+
+    payload.dt = dt;
+    payload.decoded = false;
+    payload.seqBlockIdx = payload.seqOfs = 0;
+    payload.cursorIdx = payload.cursorBlockIdx = payload.cursorOfs = 0;
+}
+
+void FileStorage::Impl::makeLazyNode(FileNode &collection, size_t nelems, size_t payloadIdx) {
+    // sequence node with the number of elements and the index of the payload instead of the elements
+    convertToCollection(FileNode::SEQ, collection);
+    bool named = collection.isNamed();
+    uchar *p = reserveNodeSpace(collection, 1 + (named ? 4 : 0) + 12);
+    *p++ |= CV_FS_LAZY_NODE;
+    if (named)
+        p += 4;
+    writeInt(p, 8);
+    writeInt(p + 4, (int) nelems);
+    writeInt(p + 8, (int) payloadIdx);
+}
+
+void FileStorage::Impl::parseBase64Collection(FileNode &collection) {
     const int BASE64_HDR_SIZE = 24;
     char dt[BASE64_HDR_SIZE + 1] = {0};
-    base64decoder.init(parser_do_not_use_direct_dereference, ptr, indent);
 
     int i, k;
 
@@ -1839,7 +2056,82 @@ char *FileStorage::Impl::parseBase64(char *ptr, int indent, FileNode &collection
     }
 
     finalizeCollection(collection);
-    return base64decoder.getPtr();
+}
+
+FileStorage::Impl::LazyBase64Payload &FileStorage::Impl::getLazyPayload(size_t blockIdx, size_t ofs) {
+    const uchar *p = getNodePtr(blockIdx, ofs);
+    CV_Assert((*p & CV_FS_LAZY_NODE) != 0);
+    if (*p & FileNode::NAMED)
+        p += 4;
+    size_t payloadIdx = (size_t) (unsigned) readInt(p + 9);
+    CV_Assert(payloadIdx < lazy_payloads.size());
+    return lazy_payloads[payloadIdx];
+}
+
+void FileStorage::Impl::decodeLazyPayload(LazyBase64Payload &payload) {
+    if (payload.decoded)
+        return;
+
+    // the regular sequence is appended after all parsed nodes
+    FileNode seq(this, fs_data_ptrs.size() - 1, freeSpaceOfs);
+    uchar *p = reserveNodeSpace(seq, 9);
+    *p = FileNode::SEQ;
+    writeInt(p + 1, 4);
+    writeInt(p + 5, 0);
+
+    if (payload.raw)
+        base64decoder.init(payload.raw, payload.nbytes);
+    else
+        base64decoder.init(payload.text.c_str(), payload.text.size());
+    parseBase64Collection(seq);
+    CV_Assert(seq.size() == payload.nelems);
+
+    payload.decoded = true;
+    payload.seqBlockIdx = seq.blockIdx;
+    payload.seqOfs = seq.ofs;
+    payload.cursorIdx = 0;
+    payload.cursorBlockIdx = seq.blockIdx;
+    payload.cursorOfs = seq.ofs + 9;
+    normalizeNodeOfs(payload.cursorBlockIdx, payload.cursorOfs);
+}
+
+FileNode FileStorage::Impl::getLazyElement(size_t blockIdx, size_t ofs, size_t idx) {
+    LazyBase64Payload &payload = getLazyPayload(blockIdx, ofs);
+    CV_Assert(idx < payload.nelems);
+    decodeLazyPayload(payload);
+
+    // sequential access is O(1) with the cursor
+    if (idx < payload.cursorIdx) {
+        payload.cursorIdx = 0;
+        payload.cursorBlockIdx = payload.seqBlockIdx;
+        payload.cursorOfs = payload.seqOfs + 9;
+        normalizeNodeOfs(payload.cursorBlockIdx, payload.cursorOfs);
+    }
+    for (; payload.cursorIdx < idx; payload.cursorIdx++) {
+        FileNode n(this, payload.cursorBlockIdx, payload.cursorOfs);
+        payload.cursorOfs += n.rawSize();
+        normalizeNodeOfs(payload.cursorBlockIdx, payload.cursorOfs);
+    }
+    return FileNode(this, payload.cursorBlockIdx, payload.cursorOfs);
+}
+
+bool FileStorage::Impl::readLazyRaw(size_t blockIdx, size_t ofs, size_t idx, int depth, uchar *dst, size_t count) {
+#if CV_LITTLE_ENDIAN_MEM_ACCESS || (defined __BYTE_ORDER__ && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    const LazyBase64Payload &payload = getLazyPayload(blockIdx, ofs);
+    if (payload.depth != depth)
+        return false;
+    CV_Assert(idx + count <= payload.nelems);
+    size_t esz = CV_ELEM_SIZE(depth);
+    if (payload.raw)
+        memcpy(dst, payload.raw + ::base64::HEADER_SIZE + idx * esz, count * esz);
+    else
+        decodeBase64Range(payload.text.c_str(), ::base64::HEADER_SIZE + idx * esz, dst, count * esz);
+    return true;
+#else
+    // the payload is little-endian, elements are converted by the regular path
+    CV_UNUSED(blockIdx); CV_UNUSED(ofs); CV_UNUSED(idx); CV_UNUSED(depth); CV_UNUSED(dst); CV_UNUSED(count);
+    return false;
+#endif
 }
 
 void FileStorage::Impl::parseError(const char *func_name, const std::string &err_msg, const char *source_file,
@@ -2475,6 +2767,14 @@ FileNodeIterator::FileNodeIterator( const FileNode& node, bool seekEnd )
                 ofs += node.rawSize();
             }
         }
+        else if( *node.ptr() & CV_FS_LAZY_NODE )
+        {
+            // deferred Base64 payload: the iterator stays at the node, elements are addressed by idx
+            nodeNElems = node.size();
+            idx = seekEnd ? nodeNElems : 0;
+            blockSize = 0;
+            return;
+        }
         else
         {
             nodeNElems = node.size();
@@ -2518,6 +2818,8 @@ FileNodeIterator& FileNodeIterator::operator=(const FileNodeIterator& it)
 
 FileNode FileNodeIterator::operator *() const
 {
+    if( fs && blockSize == 0 && idx < nodeNElems )
+        return fs->getLazyElement(blockIdx, ofs, idx);
     return FileNode(idx < nodeNElems ? fs : NULL, blockIdx, ofs);
 }
 
@@ -2526,6 +2828,8 @@ FileNodeIterator& FileNodeIterator::operator ++ ()
     if( idx == nodeNElems || !fs )
         return *this;
     idx++;
+    if( blockSize == 0 )
+        return *this;
     FileNode n(fs, blockIdx, ofs);
     ofs += n.rawSize();
     if( ofs >= blockSize )
@@ -2563,6 +2867,24 @@ FileNodeIterator& FileNodeIterator::readRaw( const String& fmt, void* _data0, si
         CV_Assert( maxsz % esz == 0 );
         maxsz /= esz;
 
+        if( blockSize == 0 )
+        {
+            // deferred Base64 payload: decode elements straight into the destination buffer
+            int depth = fmt_pairs[1];
+            for( int k = 1; k < fmt_pair_count; k++ )
+                if( fmt_pairs[k*2+1] != depth )
+                    depth = -1;
+            if( depth >= 0 )
+            {
+                size_t count = std::min(maxsz*(esz/CV_ELEM_SIZE(depth)), nodeNElems - idx);
+                if( fs->readLazyRaw(blockIdx, ofs, idx, depth, data0, count) )
+                {
+                    idx += count;
+                    return *this;
+                }
+            }
+        }
+
         for( ; maxsz > 0; maxsz--, data0 += esz )
         {
             size_t offset = 0;
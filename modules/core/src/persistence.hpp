@@ -44,6 +44,11 @@ enum
 #define CV_FS_MAX_LEN 4096
 #define CV_FS_MAX_FMT_PAIRS  128
 
+// FileStorage::LAZY: Base64 payloads with at least this number of characters are decoded on demand
+#define CV_FS_LAZY_BASE64_MIN_LEN 4096
+// internal flag of FileNode tag: sequence with deferred Base64 payload (FileStorage::LAZY)
+#define CV_FS_LAZY_NODE 64
+
 /****************************************************************************************\
 *                            Common macros and type definitions                          *
 \****************************************************************************************/
@@ -95,6 +100,9 @@ CV_DEPRECATED char* encodeFormat( int elem_type, char* dt );
 char* encodeFormat( int elem_type, char* dt, size_t dt_len );
 int decodeFormat( const char* dt, int* fmt_pairs, int max_len );
 int decodeSimpleFormat( const char* dt );
+
+//! makes the matrix a view of the array stored in FileStorage::FORMAT_BINARY file, returns false if it is not possible
+bool readMatView( const FileNode& data_node, int dims, const int* sizes, int type, Mat& m );
 }
 
 
@@ -200,6 +208,13 @@ public:
     virtual void startNextStream() = 0;
 };
 
+class FileStorageBinaryEmitter : public FileStorageEmitter
+{
+public:
+    virtual void writeRawData(const char* dt, const void* data, size_t len) = 0;
+    virtual void finish() = 0;
+};
+
 class FileStorageParser
 {
 public:
@@ -6,9 +6,71 @@
 #include "persistence_impl.hpp"
 #include "persistence_base64_encoding.hpp"
 
+#include "persistence_base64_encoding.simd.hpp"
+#include "persistence_base64_encoding.simd_declarations.hpp" // defines CV_CPU_DISPATCH_MODES_ALL=AVX2,...,BASELINE based on CMakeLists.txt content
+
+#if defined __i386__ || defined(_M_IX86) || defined __x86_64__ || defined(_M_X64) || \
+    (defined __BYTE_ORDER__ && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define CV_BASE64_LITTLE_ENDIAN 1
+#else
+#define CV_BASE64_LITTLE_ENDIAN 0
+#endif
+
 namespace cv
 {
 
+// large blocks are encoded and decoded by several threads
+static const size_t BASE64_PARALLEL_BLOCK = 1U << 15; // triplets (quads) per task
+static const size_t BASE64_PARALLEL_MIN = BASE64_PARALLEL_BLOCK * 4;
+
+static void encodeTriplets(const uchar* src, uchar* dst, size_t ntriplets)
+{
+    using namespace base64;
+    CV_CPU_DISPATCH(base64EncodeTriplets, (src, dst, ntriplets),
+        CV_CPU_DISPATCH_MODES_ALL);
+}
+
+static void decodeQuads(const uchar* src, uchar* dst, size_t nquads)
+{
+    using namespace base64;
+    CV_CPU_DISPATCH(base64DecodeQuads, (src, dst, nquads),
+        CV_CPU_DISPATCH_MODES_ALL);
+}
+
+void base64::base64_encode_triplets(const uchar* src, uchar* dst, size_t ntriplets)
+{
+    if (ntriplets < BASE64_PARALLEL_MIN || getNumThreads() <= 1)
+    {
+        encodeTriplets(src, dst, ntriplets);
+        return;
+    }
+
+    int nblocks = (int)((ntriplets + BASE64_PARALLEL_BLOCK - 1) / BASE64_PARALLEL_BLOCK);
+    parallel_for_(Range(0, nblocks), [&](const Range& r)
+    {
+        size_t start = r.start * BASE64_PARALLEL_BLOCK;
+        size_t end = std::min(r.end * BASE64_PARALLEL_BLOCK, ntriplets);
+        encodeTriplets(src + start * 3, dst + start * 4, end - start);
+    });
+}
+
+void base64::base64_decode_quads(const uchar* src, uchar* dst, size_t nquads)
+{
+    if (nquads < BASE64_PARALLEL_MIN || getNumThreads() <= 1)
+    {
+        decodeQuads(src, dst, nquads);
+        return;
+    }
+
+    int nblocks = (int)((nquads + BASE64_PARALLEL_BLOCK - 1) / BASE64_PARALLEL_BLOCK);
+    parallel_for_(Range(0, nblocks), [&](const Range& r)
+    {
+        size_t start = r.start * BASE64_PARALLEL_BLOCK;
+        size_t end = std::min(r.end * BASE64_PARALLEL_BLOCK, nquads);
+        decodeQuads(src + start * 4, dst + start * 3, end - start);
+    });
+}
+
 class base64::Base64ContextEmitter
 {
 public:
@@ -46,6 +108,14 @@ public:
             return *this;
 
         while (beg < end) {
+            if (src_cur == src_beg && static_cast<size_t>(end - beg) >= BUFFER_LEN) {
+                /* large data is encoded directly, without copying to binary buffer */
+                size_t len = std::min(static_cast<size_t>(end - beg) / BUFFER_LEN, static_cast<size_t>(DIRECT_MAX_BUFFERS)) * BUFFER_LEN;
+                emit(beg, len);
+                beg += len;
+                continue;
+            }
+
             /* collect binary data and copy to binary buffer */
             size_t len = std::min(end - beg, src_end - src_cur);
             std::memcpy(src_cur, beg, len);
@@ -87,12 +157,22 @@ public:
 
     bool flush()
     {
-        /* control line width, so on. */
-        size_t len = base64_encode(src_beg, base64_buffer.data(), 0U, src_cur - src_beg);
-        if (len == 0U)
+        size_t cnt = src_cur - src_beg;
+        if (cnt == 0U)
             return false;
 
+        emit(src_beg, cnt);
         src_cur = src_beg;
+        return true;
+    }
+
+private:
+    /* encodes data to base64 buffer and sends result to fs, split to indented lines if needed */
+    void emit(const uchar * data, size_t cnt)
+    {
+        if (base64_buffer.size() < base64_encode_buffer_size(cnt))
+            base64_buffer.resize(base64_encode_buffer_size(cnt));
+        size_t len = base64_encode(data, base64_buffer.data(), 0U, cnt);
 
         if ( !needs_indent)
         {
@@ -100,24 +180,33 @@ public:
         }
         else
         {
-            const char newline[] = "\n";
-            char space[80];
-            int ident = file_storage.write_stack.back().indent;
-            memset(space, ' ', static_cast<int>(ident));
-            space[ident] = '\0';
+            /* all lines are collected into one buffer to send them at once */
+            size_t ident = static_cast<size_t>(file_storage.write_stack.back().indent);
+            size_t nlines = (len + LINE_LEN - 1) / LINE_LEN;
+            text_buffer.resize(len + nlines * (ident + 1) + 1);
+            char * dst = text_buffer.data();
 
-            file_storage.puts(space);
-            file_storage.puts((const char*)base64_buffer.data());
-            file_storage.puts(newline);
+            for (size_t ofs = 0; ofs < len; ofs += LINE_LEN)
+            {
+                size_t line_len = std::min(len - ofs, static_cast<size_t>(LINE_LEN));
+                memset(dst, ' ', ident);
+                dst += ident;
+                memcpy(dst, base64_buffer.data() + ofs, line_len);
+                dst += line_len;
+                *dst++ = '\n';
+            }
+            *dst = '\0';
+
+            file_storage.puts(text_buffer.data());
             file_storage.flush();
         }
-
-        return true;
     }
 
 private:
-    /* because of Base64, we must keep its length a multiple of 3 */
-    static const size_t BUFFER_LEN = 48U;
+    /* one line of output contains 48 bytes of binary data */
+    static const size_t LINE_LEN = 64U;
+    static const size_t BUFFER_LEN = 48U * 256U;
+    static const size_t DIRECT_MAX_BUFFERS = 256U;
     // static_assert(BUFFER_LEN % 3 == 0, "BUFFER_LEN is invalid");
 
 private:
@@ -126,6 +215,7 @@ private:
 
     std::vector<uchar> binary_buffer;
     std::vector<uchar> base64_buffer;
+    std::vector<char> text_buffer;
     uchar * src_beg;
     uchar * src_cur;
     uchar * src_end;
@@ -157,15 +247,9 @@ size_t base64::base64_encode(const uint8_t *src, uint8_t *dst, size_t off, size_
     uint8_t const * src_end = src_cur + cnt / 3U * 3U;
 
     /* integer multiples part */
-    while (src_cur < src_end) {
-        uint8_t _2 = *src_cur++;
-        uint8_t _1 = *src_cur++;
-        uint8_t _0 = *src_cur++;
-        *dst_cur++ = base64_mapping[ _2          >> 2U];
-        *dst_cur++ = base64_mapping[(_1 & 0xF0U) >> 4U | (_2 & 0x03U) << 4U];
-        *dst_cur++ = base64_mapping[(_0 & 0xC0U) >> 6U | (_1 & 0x0FU) << 2U];
-        *dst_cur++ = base64_mapping[ _0 & 0x3FU];
-    }
+    base64_encode_triplets(src_cur, dst_cur, cnt / 3U);
+    dst_cur += cnt / 3U * 4U;
+    src_cur = src_end;
 
     /* remainder part */
     size_t rst = src_beg + cnt - src_cur;
@@ -231,6 +315,14 @@ void base64::Base64Writer::write(const void* _data, size_t len, const char* dt)
 {
     check_dt(dt);
     RawDataToBinaryConvertor convertor(_data, static_cast<int>(len), data_type_string);
+#if CV_BASE64_LITTLE_ENDIAN
+    if (convertor.is_packed()) {
+        /* elements without padding have the same binary representation in memory */
+        const uchar * beg = reinterpret_cast<const uchar *>(_data);
+        emitter->write(beg, beg + len);
+        return;
+    }
+#endif
     emitter->write(convertor);
 }
 
@@ -26,6 +26,12 @@ std::string make_base64_header(const char * dt);
 
 size_t base64_encode(uint8_t const * src, uint8_t * dst, size_t off, size_t cnt);
 
+//! encodes 'ntriplets' groups of 3 bytes to 4 characters each, without padding and terminating zero
+void base64_encode_triplets(const uchar * src, uchar * dst, size_t ntriplets);
+
+//! decodes 'nquads' groups of 4 characters to 3 bytes each, characters out of the alphabet are decoded as zeros
+void base64_decode_quads(const uchar * src, uchar * dst, size_t nquads);
+
 
 int icvCalcStructSize( const char* dt, int initial_size );
 
@@ -99,6 +105,9 @@ public:
     inline RawDataToBinaryConvertor & operator >>(uchar * & dst);
     inline operator bool() const;
 
+    /* checks if elements have no padding, i.e. binary data is the same as raw data on little-endian */
+    bool is_packed() const { return step == step_packed; }
+
 private:
     typedef size_t(*to_binary_t)(const uchar *, uchar *);
     struct elem_to_binary_t
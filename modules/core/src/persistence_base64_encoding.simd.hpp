@@ -0,0 +1,131 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#include "precomp.hpp"
+
+namespace cv { namespace base64 {
+
+CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
+
+void base64EncodeTriplets(const uchar* src, uchar* dst, size_t ntriplets);
+void base64DecodeQuads(const uchar* src, uchar* dst, size_t nquads);
+
+#ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+static inline uchar encodeChar(uchar v)
+{
+    return (uchar)(v < 26 ? 'A' + v : v < 52 ? 'a' + v - 26 : v < 62 ? '0' + v - 52 : v == 62 ? '+' : '/');
+}
+
+// characters out of the alphabet (including padding) are decoded as zeros
+static inline uchar decodeChar(uchar c)
+{
+    return (uchar)(c >= 'A' && c <= 'Z' ? c - 'A' : c >= 'a' && c <= 'z' ? c - 'a' + 26 :
+                   c >= '0' && c <= '9' ? c - '0' + 52 : c == '+' ? 62 : c == '/' ? 63 : 0);
+}
+
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+// there are no 8-bit shifts, 16-bit shifts are used and the bits moved between bytes are masked out
+template<int n> static inline v_uint8 v_shr8(const v_uint8& a)
+{
+    return v_and(v_reinterpret_as_u8(v_shr<n>(v_reinterpret_as_u16(a))), vx_setall_u8((uchar)(0xFF >> n)));
+}
+
+template<int n> static inline v_uint8 v_shl8(const v_uint8& a)
+{
+    return v_and(v_reinterpret_as_u8(v_shl<n>(v_reinterpret_as_u16(a))), vx_setall_u8((uchar)(0xFF << n)));
+}
+
+static inline v_uint8 v_encodeChars(const v_uint8& v)
+{
+    v_uint8 ofs = vx_setall_u8((uchar)'A');
+    ofs = v_select(v_gt(v, vx_setall_u8(25)), vx_setall_u8((uchar)('a' - 26)), ofs);
+    ofs = v_select(v_gt(v, vx_setall_u8(51)), vx_setall_u8((uchar)('0' - 52)), ofs);
+    ofs = v_select(v_eq(v, vx_setall_u8(62)), vx_setall_u8((uchar)('+' - 62)), ofs);
+    ofs = v_select(v_eq(v, vx_setall_u8(63)), vx_setall_u8((uchar)('/' - 63)), ofs);
+    return v_add_wrap(v, ofs);
+}
+
+static inline v_uint8 v_inRange(const v_uint8& c, uchar lo, uchar hi)
+{
+    return v_and(v_ge(c, vx_setall_u8(lo)), v_le(c, vx_setall_u8(hi)));
+}
+
+static inline v_uint8 v_decodeChars(const v_uint8& c)
+{
+    v_uint8 v = vx_setzero_u8();
+    v = v_select(v_inRange(c, 'A', 'Z'), v_sub_wrap(c, vx_setall_u8((uchar)'A')), v);
+    v = v_select(v_inRange(c, 'a', 'z'), v_sub_wrap(c, vx_setall_u8((uchar)('a' - 26))), v);
+    v = v_select(v_inRange(c, '0', '9'), v_add_wrap(c, vx_setall_u8((uchar)(52 - '0'))), v);
+    v = v_select(v_eq(c, vx_setall_u8((uchar)'+')), vx_setall_u8(62), v);
+    v = v_select(v_eq(c, vx_setall_u8((uchar)'/')), vx_setall_u8(63), v);
+    return v;
+}
+#endif
+
+void base64EncodeTriplets(const uchar* src, uchar* dst, size_t ntriplets)
+{
+    CV_INSTRUMENT_REGION();
+
+    size_t i = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const size_t vlanes = VTraits<v_uint8>::vlanes();
+    const v_uint8 v_mask6 = vx_setall_u8(63);
+    for (; i + vlanes <= ntriplets; i += vlanes, src += vlanes * 3, dst += vlanes * 4)
+    {
+        v_uint8 s0, s1, s2;
+        v_load_deinterleave(src, s0, s1, s2);
+        // aaaaaabb bbbbcccc ccdddddd => aaaaaa bbbbbb cccccc dddddd
+        v_uint8 a = v_shr8<2>(s0);
+        v_uint8 b = v_or(v_and(v_shl8<4>(s0), v_mask6), v_shr8<4>(s1));
+        v_uint8 c = v_or(v_and(v_shl8<2>(s1), v_mask6), v_shr8<6>(s2));
+        v_uint8 d = v_and(s2, v_mask6);
+        v_store_interleave(dst, v_encodeChars(a), v_encodeChars(b), v_encodeChars(c), v_encodeChars(d));
+    }
+    vx_cleanup();
+#endif
+    for (; i < ntriplets; i++, src += 3, dst += 4)
+    {
+        uchar s0 = src[0], s1 = src[1], s2 = src[2];
+        dst[0] = encodeChar(s0 >> 2);
+        dst[1] = encodeChar(((s0 & 0x03) << 4) | (s1 >> 4));
+        dst[2] = encodeChar(((s1 & 0x0F) << 2) | (s2 >> 6));
+        dst[3] = encodeChar(s2 & 0x3F);
+    }
+}
+
+void base64DecodeQuads(const uchar* src, uchar* dst, size_t nquads)
+{
+    CV_INSTRUMENT_REGION();
+
+    size_t i = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const size_t vlanes = VTraits<v_uint8>::vlanes();
+    for (; i + vlanes <= nquads; i += vlanes, src += vlanes * 4, dst += vlanes * 3)
+    {
+        v_uint8 c0, c1, c2, c3;
+        v_load_deinterleave(src, c0, c1, c2, c3);
+        // dddddd cccccc bbbbbb aaaaaa => ddddddcc ccccbbbb bbaaaaaa
+        v_uint8 d = v_decodeChars(c0), c = v_decodeChars(c1);
+        v_uint8 b = v_decodeChars(c2), a = v_decodeChars(c3);
+        v_store_interleave(dst, v_or(v_shl8<2>(d), v_shr8<4>(c)),
+                                v_or(v_shl8<4>(c), v_shr8<2>(b)),
+                                v_or(v_shl8<6>(b), a));
+    }
+    vx_cleanup();
+#endif
+    for (; i < nquads; i++, src += 4, dst += 3)
+    {
+        uchar d = decodeChar(src[0]), c = decodeChar(src[1]);
+        uchar b = decodeChar(src[2]), a = decodeChar(src[3]);
+        dst[0] = (uchar)((d << 2) | (c >> 4));
+        dst[1] = (uchar)((c << 4) | (b >> 2));
+        dst[2] = (uchar)((b << 6) | a);
+    }
+}
+
+#endif // CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+CV_CPU_OPTIMIZATION_NAMESPACE_END
+}} // namespace
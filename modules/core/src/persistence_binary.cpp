@@ -0,0 +1,486 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#include "precomp.hpp"
+#include "persistence.hpp"
+#include "persistence_impl.hpp"
+
+#if defined __unix__ || defined __APPLE__
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define CV_FS_BINARY_HAVE_MMAP 1
+#endif
+
+/*
+  FileStorage::FORMAT_BINARY file layout (all numbers are little-endian):
+
+  header (64 bytes):
+    "CVFSBIN1"                              signature
+    uint64 offset, uint64 size              names of map elements (FileStorage::Impl::str_hash_data)
+    uint64 offset, uint64 size              tree of nodes (FileStorage::Impl::fs_data as a single block)
+    uint64 offset, uint64 count             table of arrays: (uint64 offset, uint64 size) per array
+  arrays:
+    24 bytes header with the format of elements (the same as Base64 header), data aligned to 64 bytes
+  names, nodes, table of arrays
+
+  Arrays are referenced by sequence nodes with deferred payload (CV_FS_LAZY_NODE),
+  so they are accessed in the same way as Base64 payloads of FileStorage::LAZY mode.
+*/
+
+namespace cv
+{
+
+static const char binarySignature[] = "CVFSBIN1";
+
+enum
+{
+    BINARY_SIGNATURE_SIZE = 8,
+    BINARY_HEADER_SIZE = 64,
+    BINARY_ARRAY_ALIGN = 64
+};
+
+static inline void putUInt32(uchar* p, unsigned val)
+{
+    for (int i = 0; i < 4; i++)
+        p[i] = (uchar)(val >> (i * 8));
+}
+
+static inline void putUInt64(uchar* p, uint64 val)
+{
+    for (int i = 0; i < 8; i++)
+        p[i] = (uchar)(val >> (i * 8));
+}
+
+static inline uint64 getUInt64(const uchar* p)
+{
+    uint64 val = 0;
+    for (int i = 7; i >= 0; i--)
+        val = (val << 8) | p[i];
+    return val;
+}
+
+static inline bool isValidRange(uint64 ofs, uint64 size, size_t total)
+{
+    return ofs <= total && size <= total - ofs;
+}
+
+static void seekFile(FILE* f, uint64 ofs)
+{
+#ifdef _WIN32
+    int res = _fseeki64(f, (__int64)ofs, SEEK_SET);
+#else
+    int res = fseek(f, (long)ofs, SEEK_SET);
+#endif
+    if (res != 0)
+        CV_Error(Error::StsError, "Can't seek in the file");
+}
+
+struct BinaryStorageData
+{
+    BinaryStorageData() : data(0), size(0), mapped(false) {}
+    ~BinaryStorageData()
+    {
+#ifdef CV_FS_BINARY_HAVE_MMAP
+        if (mapped)
+        {
+            munmap(data, size);
+            return;
+        }
+#endif
+        fastFree(data);
+    }
+
+    uchar* data;
+    size_t size;
+    bool mapped;
+};
+
+//! keeps content of the file alive while there are matrices which refer to it
+class BinaryStorageMatAllocator CV_FINAL : public MatAllocator
+{
+public:
+    UMatData* allocate(int dims, const int* sizes, int type,
+                       void* data, size_t* step, AccessFlag flags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        return Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usageFlags);
+    }
+
+    bool allocate(UMatData* u, AccessFlag accessFlags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        return Mat::getStdAllocator()->allocate(u, accessFlags, usageFlags);
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if (!u)
+            return;
+
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        delete (Ptr<BinaryStorageData>*)u->userdata;
+        u->userdata = 0;
+        delete u;
+    }
+};
+
+static BinaryStorageMatAllocator& getBinaryStorageMatAllocator()
+{
+    CV_SINGLETON_LAZY_INIT_REF(BinaryStorageMatAllocator, new BinaryStorageMatAllocator())
+}
+
+class BinaryEmitter CV_FINAL : public FileStorageBinaryEmitter
+{
+public:
+    BinaryEmitter(FileStorage::Impl* _fs) : fs(_fs), pos(0), raw_active(false), raw_start(0), raw_size(0)
+    {
+        // the header is written by finish()
+        uchar header[BINARY_HEADER_SIZE] = {0};
+        putBytes(header, sizeof(header));
+
+        // the root sequence of streams, the same as the parsers create
+        FileNode root(fs, 0, 0);
+        uchar* ptr = fs->reserveNodeSpace(root, 9);
+        *ptr = FileNode::SEQ;
+        putUInt32(ptr + 1, 4);
+        putUInt32(ptr + 5, 0);
+        stack.push_back(root);
+        startNextStream();
+    }
+
+    FStructData startWriteStruct(const FStructData&, const char* key,
+                                 int struct_flags, const char* type_name) CV_OVERRIDE
+    {
+        flushRawData();
+        FileNode node = fs->addNode(stack.back(), key ? key : std::string(), struct_flags & FileNode::TYPE_MASK, 0, -1);
+        stack.push_back(node);
+        fs->setNonEmpty();
+        return FStructData(type_name ? type_name : "", struct_flags, 0);
+    }
+
+    void endWriteStruct(const FStructData&) CV_OVERRIDE
+    {
+        CV_Assert(stack.size() > 1);
+        endCollection();
+    }
+
+    void write(const char* key, int value) CV_OVERRIDE
+    {
+        flushRawData();
+        fs->addNode(stack.back(), key ? key : std::string(), FileNode::INT, &value, -1);
+        fs->setNonEmpty();
+    }
+
+    void write(const char* key, double value) CV_OVERRIDE
+    {
+        flushRawData();
+        fs->addNode(stack.back(), key ? key : std::string(), FileNode::REAL, &value, -1);
+        fs->setNonEmpty();
+    }
+
+    void write(const char* key, const char* value, bool) CV_OVERRIDE
+    {
+        flushRawData();
+        fs->addNode(stack.back(), key ? key : std::string(), FileNode::STRING, value, -1);
+        fs->setNonEmpty();
+    }
+
+    void writeScalar(const char* key, const char* value) CV_OVERRIDE
+    {
+        write(key, value, false);
+    }
+
+    void writeComment(const char*, bool) CV_OVERRIDE
+    {
+        // comments are not stored
+    }
+
+    void startNextStream() CV_OVERRIDE
+    {
+        CV_Assert(stack.size() == 1);
+        FileNode node = fs->addNode(stack.back(), std::string(), FileNode::MAP, 0, -1);
+        stack.push_back(node);
+    }
+
+    void writeRawData(const char* dt, const void* data, size_t len) CV_OVERRIDE
+    {
+        size_t elemSize = fs::calcStructSize(dt, 0);
+        CV_Assert(elemSize > 0);
+        CV_Assert(len % elemSize == 0);
+        if (len == 0)
+            return;
+        if (!data)
+            CV_Error(cv::Error::StsNullPtr, "Null data pointer");
+
+        FileNode& collection = stack.back();
+        if (raw_active && raw_dt == dt)
+        {
+            putBytes(data, len);
+            raw_size += len;
+            return;
+        }
+        flushRawData();
+
+        if (collection.isSeq() && collection.size() == 0)
+        {
+            // the array is written right away, it becomes a node with deferred payload in the end of the sequence
+            std::string header = base64::make_base64_header(dt);
+            CV_Assert(header.size() == (size_t)::base64::HEADER_SIZE);
+            uchar zeros[BINARY_ARRAY_ALIGN] = {0};
+            putBytes(zeros, (size_t)((BINARY_ARRAY_ALIGN * 2 - (pos + ::base64::HEADER_SIZE) % BINARY_ARRAY_ALIGN) % BINARY_ARRAY_ALIGN));
+            raw_active = true;
+            raw_dt = dt;
+            raw_start = pos;
+            raw_size = 0;
+            putBytes(header.c_str(), header.size());
+            putBytes(data, len);
+            raw_size += len;
+            return;
+        }
+
+        // sequence with other elements: the array is stored element by element
+        std::vector<uchar> buf;
+        std::string header = base64::make_base64_header(dt);
+        buf.reserve(header.size() + len);
+        buf.insert(buf.end(), header.begin(), header.end());
+        buf.insert(buf.end(), (const uchar*)data, (const uchar*)data + len);
+        addElements(buf);
+    }
+
+    void finish() CV_OVERRIDE
+    {
+        while (stack.size() > 1)
+            endCollection();
+        fs->finalizeCollection(stack.back());
+        stack.clear();
+
+        uchar header[BINARY_HEADER_SIZE] = {0};
+        memcpy(header, binarySignature, BINARY_SIGNATURE_SIZE);
+
+        putUInt64(header + 8, pos);
+        putUInt64(header + 16, fs->str_hash_data.size());
+        putBytes(&fs->str_hash_data[0], fs->str_hash_data.size());
+
+        uint64 nodes_ofs = pos;
+        size_t nblocks = fs->fs_data_ptrs.size();
+        for (size_t i = 0; i < nblocks; i++)
+            putBytes(fs->fs_data_ptrs[i], i + 1 < nblocks ? fs->fs_data_blksz[i] : fs->freeSpaceOfs);
+        putUInt64(header + 24, nodes_ofs);
+        putUInt64(header + 32, pos - nodes_ofs);
+
+        putUInt64(header + 40, pos);
+        putUInt64(header + 48, arrays.size());
+        for (size_t i = 0; i < arrays.size(); i++)
+        {
+            uchar entry[16];
+            putUInt64(entry, arrays[i].first);
+            putUInt64(entry + 8, arrays[i].second);
+            putBytes(entry, sizeof(entry));
+        }
+
+        seekFile(fs->file, 0);
+        if (fwrite(header, 1, sizeof(header), fs->file) != sizeof(header))
+            CV_Error(cv::Error::StsError, "Can't write to the file");
+    }
+
+protected:
+    void putBytes(const void* data, size_t len)
+    {
+        if (len > 0 && fwrite(data, 1, len, fs->file) != len)
+            CV_Error(cv::Error::StsError, "Can't write to the file");
+        pos += len;
+    }
+
+    void endCollection()
+    {
+        FileNode& node = stack.back();
+        if (raw_active)
+        {
+            FileStorage::Impl::LazyBase64Payload payload;
+            std::string header = base64::make_base64_header(raw_dt.c_str());
+            fs->initLazyPayload(payload, (const uchar*)header.c_str(), ::base64::HEADER_SIZE + raw_size);
+            fs->makeLazyNode(node, payload.nelems, arrays.size());
+            arrays.push_back(std::make_pair(raw_start, (uint64)::base64::HEADER_SIZE + raw_size));
+            raw_active = false;
+        }
+        else
+            fs->finalizeCollection(node);
+        stack.pop_back();
+    }
+
+    //! the sequence gets other elements after the array: elements of the array are converted to nodes
+    void flushRawData()
+    {
+        if (!raw_active)
+            return;
+        raw_active = false;
+
+        std::vector<uchar> buf((size_t)(::base64::HEADER_SIZE + raw_size));
+        fflush(fs->file);
+        seekFile(fs->file, raw_start);
+        if (fread(&buf[0], 1, buf.size(), fs->file) != buf.size())
+            CV_Error(cv::Error::StsError, "Can't read from the file");
+        seekFile(fs->file, raw_start);
+        pos = raw_start;
+        addElements(buf);
+    }
+
+    void addElements(const std::vector<uchar>& buf)
+    {
+        fs->base64decoder.init(&buf[0], buf.size());
+        fs->parseBase64Collection(stack.back());
+    }
+
+    FileStorage::Impl* fs;
+    std::vector<FileNode> stack;
+    std::vector<std::pair<uint64, uint64> > arrays;
+    uint64 pos;
+
+    bool raw_active;
+    std::string raw_dt;
+    uint64 raw_start;
+    uint64 raw_size;
+};
+
+Ptr<FileStorageBinaryEmitter> createBinaryEmitter(FileStorage::Impl* fs)
+{
+    return makePtr<BinaryEmitter>(fs);
+}
+
+bool FileStorage::Impl::readBinary()
+{
+    char signature[BINARY_SIGNATURE_SIZE];
+    bool ok = fread(signature, 1, sizeof(signature), file) == sizeof(signature) &&
+              memcmp(signature, binarySignature, BINARY_SIGNATURE_SIZE) == 0;
+    rewind();
+    if (!ok)
+        return false;
+
+#ifdef _WIN32
+    file = freopen(filename.c_str(), "rb", file);
+    CV_Assert(file != 0);
+#endif
+
+    Ptr<BinaryStorageData> content = makePtr<BinaryStorageData>();
+#ifdef CV_FS_BINARY_HAVE_MMAP
+    struct stat st;
+    if (fstat(fileno(file), &st) == 0 && st.st_size > 0)
+    {
+        // private writable mapping: matrices are views of the file, their modification is not stored
+        void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(file), 0);
+        if (ptr != MAP_FAILED)
+        {
+            content->data = (uchar*)ptr;
+            content->size = (size_t)st.st_size;
+            content->mapped = true;
+        }
+    }
+#endif
+    if (!content->data)
+    {
+#ifdef _WIN32
+        _fseeki64(file, 0, SEEK_END);
+        size_t size = (size_t)_ftelli64(file);
+#else
+        fseek(file, 0, SEEK_END);
+        size_t size = (size_t)ftell(file);
+#endif
+        rewind();
+        content->data = (uchar*)fastMalloc(std::max(size, (size_t)1));
+        content->size = size;
+        if (fread(content->data, 1, size, file) != size)
+            CV_Error(cv::Error::StsError, "Can't read the file");
+    }
+
+    const uchar* base = content->data;
+    size_t size = content->size;
+    if (size < BINARY_HEADER_SIZE)
+        CV_Error(cv::Error::StsParseError, "Invalid binary FileStorage header");
+    uint64 strings_ofs = getUInt64(base + 8), strings_size = getUInt64(base + 16);
+    uint64 nodes_ofs = getUInt64(base + 24), nodes_size = getUInt64(base + 32);
+    uint64 arrays_ofs = getUInt64(base + 40), narrays = getUInt64(base + 48);
+    if (!isValidRange(strings_ofs, strings_size, size) || strings_size == 0 || base[strings_ofs + strings_size - 1] != 0 ||
+        !isValidRange(nodes_ofs, nodes_size, size) || nodes_size < 9 ||
+        !isValidRange(arrays_ofs, 0, size) || narrays > (size - arrays_ofs) / 16)
+        CV_Error(cv::Error::StsParseError, "Invalid binary FileStorage header");
+
+    str_hash_data.assign(base + strings_ofs, base + strings_ofs + strings_size);
+    str_hash.clear();
+    for (size_t i = 1; i < str_hash_data.size(); )
+    {
+        const char* key = &str_hash_data[i];
+        size_t len = strlen(key);
+        str_hash.insert(std::make_pair(std::string(key, len), (unsigned)i));
+        i += len + 1;
+    }
+
+    Ptr<std::vector<uchar> > block = makePtr<std::vector<uchar> >(base + nodes_ofs, base + nodes_ofs + nodes_size);
+    fs_data.clear();
+    fs_data_ptrs.clear();
+    fs_data_blksz.clear();
+    fs_data.push_back(block);
+    fs_data_ptrs.push_back(&block->at(0));
+    fs_data_blksz.push_back((size_t)nodes_size);
+    freeSpaceOfs = (size_t)nodes_size;
+
+    lazy_payloads.resize((size_t)narrays);
+    for (size_t i = 0; i < lazy_payloads.size(); i++)
+    {
+        uint64 ofs = getUInt64(base + arrays_ofs + i * 16), nbytes = getUInt64(base + arrays_ofs + i * 16 + 8);
+        if (!isValidRange(ofs, nbytes, size) || nbytes <= (uint64)::base64::HEADER_SIZE)
+            CV_Error(cv::Error::StsParseError, "Invalid array of binary FileStorage");
+        LazyBase64Payload& payload = lazy_payloads[i];
+        payload.raw = base + ofs;
+        initLazyPayload(payload, payload.raw, (size_t)nbytes);
+    }
+
+    FileNode roots_node(this, 0, 0);
+    if (!roots_node.isSeq())
+        CV_Error(cv::Error::StsParseError, "Invalid nodes of binary FileStorage");
+    roots.clear();
+    for (FileNodeIterator it = roots_node.begin(); it != roots_node.end(); ++it)
+        roots.push_back(*it);
+
+    fmt = FileStorage::FORMAT_BINARY;
+    binary_data = content;
+    return true;
+}
+
+namespace fs
+{
+
+bool readMatView(const FileNode& data_node, int dims, const int* sizes, int type, Mat& m)
+{
+#if (defined __BYTE_ORDER__ && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || \
+    defined __i386__ || defined(_M_IX86) || defined __x86_64__ || defined(_M_X64) || defined(_M_ARM64)
+    FileStorage::Impl* fs = data_node.fs;
+    const uchar* p = data_node.ptr();
+    if (!fs || !fs->binary_data || !p || (*p & CV_FS_LAZY_NODE) == 0)
+        return false;
+    const FileStorage::Impl::LazyBase64Payload& payload = fs->getLazyPayload(data_node.blockIdx, data_node.ofs);
+    size_t total = CV_MAT_CN(type);
+    for (int i = 0; i < dims; i++)
+        total *= sizes[i];
+    if (!payload.raw || payload.depth != CV_MAT_DEPTH(type) || payload.nelems != total)
+        return false;
+
+    uchar* data = (uchar*)payload.raw + ::base64::HEADER_SIZE;
+    Mat view(dims, sizes, type, data);
+    UMatData* u = new UMatData(&getBinaryStorageMatAllocator());
+    u->data = u->origdata = data;
+    u->size = total * CV_ELEM_SIZE1(type);
+    u->userdata = new Ptr<BinaryStorageData>(fs->binary_data);
+    u->refcount = 1;
+    view.u = u;
+    m = view;
+    return true;
+#else
+    // arrays are stored in little-endian byte order, they are converted by the regular path
+    CV_UNUSED(data_node); CV_UNUSED(dims); CV_UNUSED(sizes); CV_UNUSED(type); CV_UNUSED(m);
+    return false;
+#endif
+}
+
+}
+
+}
@@ -20,6 +20,8 @@ enum Base64State{
     InUse,
 };
 
+struct BinaryStorageData;
+
 class cv::FileStorage::Impl : public FileStorage_API
 {
 public:
@@ -140,6 +142,10 @@ public:
     public:
         Base64Decoder();
         void init(const Ptr<FileStorageParser>& _parser, char* _ptr, int _indent);
+        //! decode Base64 text stored in memory (separators are already removed)
+        void init(const char* _text, size_t _textlen);
+        //! read bytes which are already decoded (FileStorage::FORMAT_BINARY)
+        void init(const uchar* _raw, size_t _rawlen);
 
         bool readMore(int needed);
 
@@ -164,6 +170,10 @@ public:
         }
         char* ptr;
         int indent;
+        const char* text;
+        size_t textlen;
+        const uchar* raw;
+        size_t rawlen;
         std::vector<char> encoded;
         std::vector<uchar> decoded;
         size_t ofs;
@@ -173,6 +183,38 @@ public:
 
     char* parseBase64(char* ptr, int indent, FileNode& collection);
 
+    void parseBase64Collection(FileNode& collection);
+
+    //! Base64 payload kept in the text form until it is accessed (FileStorage::LAZY)
+    struct LazyBase64Payload
+    {
+        std::string text;       //!< Base64 characters without separators, padded with '='
+        const uchar* raw;       //!< decoded bytes of FileStorage::FORMAT_BINARY array (text is empty then)
+        std::string dt;         //!< format of the elements
+        int depth;              //!< depth of all elements or -1 if the format is a structure of different types
+        size_t nbytes;          //!< number of decoded bytes (including the header)
+        size_t nelems;          //!< number of elements
+        bool decoded;           //!< sequence of nodes has been created
+        size_t seqBlockIdx, seqOfs;             //!< the decoded sequence
+        size_t cursorIdx, cursorBlockIdx, cursorOfs;   //!< the last accessed element of the decoded sequence
+    };
+
+    void initLazyPayload(LazyBase64Payload& payload, const uchar* header, size_t nbytes);
+
+    void makeLazyNode(FileNode& collection, size_t nelems, size_t payloadIdx);
+
+    void mapFile();
+
+    bool readBinary();
+
+    LazyBase64Payload& getLazyPayload(size_t blockIdx, size_t ofs);
+
+    void decodeLazyPayload(LazyBase64Payload& payload);
+
+    FileNode getLazyElement(size_t blockIdx, size_t ofs, size_t idx);
+
+    bool readLazyRaw(size_t blockIdx, size_t ofs, size_t idx, int depth, uchar* dst, size_t count);
+
     void parseError( const char* func_name, const std::string& err_msg, const char* source_file, int source_line );
 
     const uchar* getNodePtr(size_t blockIdx, size_t ofs) const;
@@ -237,6 +279,13 @@ public:
     str_hash_t str_hash;
     std::vector<char> str_hash_data;
 
+    std::vector<LazyBase64Payload> lazy_payloads;
+    void* mapped_data;
+    size_t mapped_size;
+
+    Ptr<FileStorageBinaryEmitter> binary_emitter;
+    Ptr<BinaryStorageData> binary_data;  //!< content of FileStorage::FORMAT_BINARY file, shared with Mat views
+
     std::vector<char> strbufv;
     char* strbuf;
     size_t strbufsize;
@@ -244,6 +293,8 @@ public:
     int lineno;
 };
 
+Ptr<FileStorageBinaryEmitter> createBinaryEmitter(FileStorage::Impl* fs);
+
 }
 
 #endif
@@ -62,6 +62,80 @@ namespace cv
 
 #define  RNG_NEXT(x)    ((uint64)(unsigned)(x)*CV_RNG_COEFF + ((x) >> 32))
 
+/*
+   For the states X < A*2^32 - 1 the multiply-with-carry step is equivalent to
+   the multiplicative congruential generator X(n+1) = A*X(n) mod (A*2^32 - 1),
+   which gives the jump-ahead X(n+k) = A^k*X(n) mod (A*2^32 - 1). It is used to fill
+   large arrays by independent blocks producing exactly the same sequence as the
+   sequential generator.
+*/
+
+static const uint64 RNG_MODULUS = (uint64)CV_RNG_COEFF*((uint64)1 << 32) - 1;
+
+enum { RAND_PARALLEL_MIN_SIZE = 1 << 16 };
+
+static inline uint64 addModRNG( uint64 a, uint64 b )
+{
+    uint64 s = a + b;
+    return s < a || s >= RNG_MODULUS ? s - RNG_MODULUS : s;
+}
+
+static uint64 mulModRNG( uint64 a, uint64 b )
+{
+    uint64 r = 0;
+    for( ; b != 0; b >>= 1 )
+    {
+        if( b & 1 )
+            r = addModRNG(r, a);
+        a = addModRNG(a, a);
+    }
+    return r;
+}
+
+// returns the state of the generator after k steps from the given (canonical) state
+static uint64 jumpRNG( uint64 state, uint64 k )
+{
+    uint64 a = CV_RNG_COEFF;
+    for( ; k != 0; k >>= 1 )
+    {
+        if( k & 1 )
+            state = mulModRNG(state, a);
+        a = mulModRNG(a, a);
+    }
+    return state;
+}
+
+/*
+   Philox4x32-10 counter-based generator from
+   "Parallel Random Numbers: As Easy as 1, 2, 3" by J. K. Salmon, M. A. Moraes,
+   R. O. Dror and D. E. Shaw, SC'11. The output is a pure function of the key
+   and the 128-bit counter.
+*/
+
+enum
+{
+    PHILOX_M0 = 0xD2511F53U, PHILOX_M1 = 0xCD9E8D57U,
+    PHILOX_W0 = 0x9E3779B9U, PHILOX_W1 = 0xBB67AE85U
+};
+
+static inline void philox4x32_10( const unsigned* ctr, const unsigned* key, unsigned* out )
+{
+    unsigned x0 = ctr[0], x1 = ctr[1], x2 = ctr[2], x3 = ctr[3];
+    unsigned k0 = key[0], k1 = key[1];
+    for( int r = 0; r < 10; r++ )
+    {
+        uint64 p0 = (uint64)PHILOX_M0*x0, p1 = (uint64)PHILOX_M1*x2;
+        x0 = (unsigned)(p1 >> 32) ^ x1 ^ k0;
+        x2 = (unsigned)(p0 >> 32) ^ x3 ^ k1;
+        x1 = (unsigned)p1;
+        x3 = (unsigned)p0;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    out[0] = x0; out[1] = x1; out[2] = x2; out[3] = x3;
+}
+
+
 /***************************************************************************************\
 *                           Pseudo-Random Number Generators (PRNGs)                     *
 \***************************************************************************************/
@@ -232,18 +306,13 @@ static RandFunc randTab[CV_DEPTH_MAX][CV_DEPTH_MAX] =
    "The Ziggurat Method for Generating Random Variables"
    by George Marsaglia and Wai Wan Tsang, Journal of Statistical Software, 2007.
 */
-static void
-randn_0_1_32f( float* arr, int len, uint64* state )
-{
-    const float r = 3.442620f; // The start of the right tail
-    const float rng_flt = 2.3283064365386962890625e-10f; // 2^-32
-    static unsigned kn[128];
-    static float wn[128], fn[128];
-    uint64 temp = *state;
-    static bool initialized=false;
-    int i;
 
-    if( !initialized )
+static const float ZIGGURAT_R = 3.442620f; // The start of the right tail
+static const float ZIGGURAT_RNG_FLT = 2.3283064365386962890625e-10f; // 2^-32
+
+struct ZigguratTables
+{
+    ZigguratTables()
     {
         const double m1 = 2147483648.0;
         double dn = 3.442619855899, tn = dn, vn = 9.91256303526217e-3;
@@ -259,7 +328,7 @@ randn_0_1_32f( float* arr, int len, uint64* state )
         fn[0] = 1.f;
         fn[127] = (float)std::exp(-.5*dn*dn);
 
-        for(i=126;i>=1;i--)
+        for(int i=126;i>=1;i--)
         {
             dn = std::sqrt(-2.*std::log(vn/dn+std::exp(-.5*dn*dn)));
             kn[i+1] = (unsigned)((dn/tn)*m1);
@@ -267,9 +336,30 @@ randn_0_1_32f( float* arr, int len, uint64* state )
             fn[i] = (float)std::exp(-.5*dn*dn);
             wn[i] = (float)(dn/m1);
         }
-        initialized = true;
     }
 
+    unsigned kn[128];
+    float wn[128], fn[128];
+};
+
+static const ZigguratTables& getZigguratTables()
+{
+    static ZigguratTables tables;
+    return tables;
+}
+
+static void
+randn_0_1_32f( float* arr, int len, uint64* state )
+{
+    const float r = ZIGGURAT_R;
+    const float rng_flt = ZIGGURAT_RNG_FLT;
+    const ZigguratTables& tables = getZigguratTables();
+    const unsigned* kn = tables.kn;
+    const float* wn = tables.wn;
+    const float* fn = tables.fn;
+    uint64 temp = *state;
+    int i;
+
     for( i = 0; i < len; i++ )
     {
         float x, y;
@@ -307,6 +397,116 @@ randn_0_1_32f( float* arr, int len, uint64* state )
     *state = temp;
 }
 
+// sequential words of the Philox stream with the counters {seed, 0, 1}, {seed, 1, 1}, ...
+struct PhiloxStream
+{
+    explicit PhiloxStream( uint64 seed ) : pos(4)
+    {
+        ctr[0] = (unsigned)seed; ctr[1] = (unsigned)(seed >> 32);
+        ctr[2] = 0; ctr[3] = 1;
+    }
+
+    unsigned next()
+    {
+        static const unsigned key[] = { 0x243F6A88U, 0x85A308D3U };
+        if( pos == 4 )
+        {
+            philox4x32_10(ctr, key, buf);
+            ctr[2]++;
+            pos = 0;
+        }
+        return buf[pos++];
+    }
+
+    unsigned ctr[4], buf[4];
+    int pos;
+};
+
+// finishes the Ziggurat sample starting with the word hz;
+// the rejected candidates are replaced using the Philox stream of the generator state
+static float
+randnRejected_( int hz, uint64 seed, const ZigguratTables& tables )
+{
+    const unsigned* kn = tables.kn;
+    const float* wn = tables.wn;
+    const float* fn = tables.fn;
+    PhiloxStream stream(seed);
+
+    for(;;)
+    {
+        int iz = hz & 127;
+        float x = hz*wn[iz], y;
+        if( (unsigned)std::abs(hz) < kn[iz] )
+            return x;
+        if( iz == 0 )
+        {
+            do
+            {
+                x = stream.next()*ZIGGURAT_RNG_FLT;
+                y = stream.next()*ZIGGURAT_RNG_FLT;
+                x = (float)(-std::log(x+FLT_MIN)*0.2904764);
+                y = (float)-std::log(y+FLT_MIN);
+            }
+            while( y + y < x*x );
+            return hz > 0 ? ZIGGURAT_R + x : -ZIGGURAT_R - x;
+        }
+        y = stream.next()*ZIGGURAT_RNG_FLT;
+        if( fn[iz] + y*(fn[iz - 1] - fn[iz]) < std::exp(-.5*x*x) )
+            return x;
+        hz = (int)stream.next();
+    }
+}
+
+/*
+   The variant of randn_0_1_32f used by RNG::fill: each value consumes exactly one
+   generator step, so the blocks of a large array can be started with the jump-ahead.
+   The first Ziggurat candidate of the value is the generator state itself, the rare
+   rejected candidates are replaced from the Philox stream of that state.
+*/
+static void
+randnFixedStep_32f( float* arr, int len, uint64* state )
+{
+    const ZigguratTables& tables = getZigguratTables();
+    uint64 temp = *state;
+    int i = 0;
+
+#if CV_SIMD128
+    const v_int32x4 v_mask = v_setall_s32(127);
+    uint64 seeds[16];
+    int buf[16];
+    for( ; i <= len - 16; i += 16 )
+    {
+        for( int k = 0; k < 16; k++ )
+        {
+            seeds[k] = temp;
+            buf[k] = (int)temp;
+            temp = RNG_NEXT(temp);
+        }
+        bool accepted = true;
+        for( int k = 0; k < 16; k += 4 )
+        {
+            v_int32x4 hz = v_load(buf + k);
+            v_int32x4 iz = v_and(hz, v_mask);
+            v_store(arr + i + k, v_mul(v_cvt_f32(hz), v_lut(tables.wn, iz)));
+            accepted = accepted && v_check_all(v_lt(v_abs(hz), v_lut(tables.kn, iz)));
+        }
+        if( !accepted )
+        {
+            for( int k = 0; k < 16; k++ )
+                if( (unsigned)std::abs(buf[k]) >= tables.kn[buf[k] & 127] )
+                    arr[i + k] = randnRejected_(buf[k], seeds[k], tables);
+        }
+    }
+#endif
+
+    for( ; i < len; i++ )
+    {
+        arr[i] = randnRejected_((int)temp, temp, tables);
+        temp = RNG_NEXT(temp);
+    }
+    *state = temp;
+}
+
 
 double RNG::gaussian(double sigma)
 {
@@ -583,8 +783,6 @@ void RNG::fill( InputOutputArray _mat, int disttype,
     size_t esz = mat.elemSize();
     AutoBuffer<double> buf;
     uchar* param = 0;
-    float* nbuf = 0;
-    float* tmpbuf = 0;
 
     if( disttype == UNIFORM )
     {
@@ -614,8 +812,6 @@ void RNG::fill( InputOutputArray _mat, int disttype,
             for( j = 0; j < blockSize*cn; j += cn )
                 for( k = 0; k < cn; k++ )
                     p[j + k] = fp[k];
-            if( depth == CV_16F )
-                tmpbuf = (float*)p + blockSize*cn*2;
         }
         else
         {
@@ -625,28 +821,65 @@ void RNG::fill( InputOutputArray _mat, int disttype,
                     p[j + k] = dp[k];
         }
     }
-    else
+
+    // the array is processed by blocks of blockSize pixels; the large arrays are filled
+    // in parallel, starting each range of blocks with the jump-ahead of the generator,
+    // which gives the same numbers as the sequential loop for any number of threads
+    std::vector<uchar*> planes(it.nplanes);
+    for( size_t i = 0; i < it.nplanes; i++, ++it )
+        planes[i] = ptr;
+
+    int planeBlocks = (total + blockSize - 1)/blockSize;
+    int nblocks = (int)it.nplanes*planeBlocks;
+    bool smallBits = disttype == UNIFORM && depth <= CV_32S && fast_int_mode && smallFlag;
+    bool parallel = nblocks > 1 && state < RNG_MODULUS &&
+                    (double)it.nplanes*total*cn >= RAND_PARALLEL_MIN_SIZE;
+    std::vector<uint64> blockOfs;
+
+    if( parallel )
     {
-        buf.allocate((blockSize*cn+1)/2);
-        nbuf = (float*)(double*)buf.data();
+        // the number of generator steps consumed by the blocks [0, b)
+        blockOfs.resize(nblocks + 1);
+        blockOfs[0] = 0;
+        for( int b = 0; b < nblocks; b++ )
+        {
+            int n = std::min(total - (b % planeBlocks)*blockSize, blockSize)*cn;
+            blockOfs[b + 1] = blockOfs[b] + (smallBits ? n/4 + n%4 : n);
+        }
     }
 
-    for( size_t i = 0; i < it.nplanes; i++, ++it )
+    uint64 state0 = state;
+    auto processBlocks = [&](const Range& r) -> uint64
     {
-        for( j = 0; j < total; j += blockSize )
+        AutoBuffer<float> _fbuf(blockSize*cn);
+        float* fbuf = _fbuf.data();
+        uint64 temp = parallel ? jumpRNG(state0, blockOfs[r.start]) : state0;
+
+        for( int b = r.start; b < r.end; b++ )
         {
-            int len = std::min(total - j, blockSize);
+            int j0 = (b % planeBlocks)*blockSize;
+            int len = std::min(total - j0, blockSize);
+            uchar* dst = planes[b / planeBlocks] + j0*esz;
 
-            if( disttype == CV_RAND_UNI )
-                func( ptr, len*cn, &state, param, tmpbuf, smallFlag );
+            if( disttype == UNIFORM )
+                func( dst, len*cn, &temp, param, fbuf, smallFlag );
             else
             {
-                randn_0_1_32f(nbuf, len*cn, &state);
-                scaleFunc(nbuf, ptr, len, cn, mean, stddev, stdmtx);
+                randnFixedStep_32f(fbuf, len*cn, &temp);
+                scaleFunc(fbuf, dst, len, cn, mean, stddev, stdmtx);
             }
-            ptr += len*esz;
         }
+        return temp;
+    };
+
+    if( parallel )
+    {
+        parallel_for_(Range(0, nblocks), [&](const Range& r) { processBlocks(r); },
+                      (double)it.nplanes*total*cn/RAND_PARALLEL_MIN_SIZE);
+        state = jumpRNG(state0, blockOfs[nblocks]);
     }
+    else
+        state = processBlocks(Range(0, nblocks));
 }
 
 }
@@ -679,17 +912,47 @@ void cv::randn(InputOutputArray dst, InputArray mean, InputArray stddev)
 namespace cv
 {
 
+// generates n successive values of (unsigned)rng % sz; large batches are generated
+// in parallel using the jump-ahead, giving the same sequence as the sequential loop
+static void randIndices_( RNG& rng, unsigned* idx, int n, unsigned sz )
+{
+    uint64 state0 = rng.state;
+    if( n < RAND_PARALLEL_MIN_SIZE || state0 >= RNG_MODULUS )
+    {
+        for( int i = 0; i < n; i++ )
+            idx[i] = (unsigned)rng % sz;
+        return;
+    }
+
+    parallel_for_(Range(0, n), [&](const Range& r)
+    {
+        uint64 temp = jumpRNG(state0, (uint64)r.start);
+        for( int i = r.start; i < r.end; i++ )
+        {
+            temp = RNG_NEXT(temp);
+            idx[i] = (unsigned)temp % sz;
+        }
+    }, (double)n/(RAND_PARALLEL_MIN_SIZE/4));
+    rng.state = jumpRNG(state0, (uint64)n);
+}
+
+enum { RAND_SHUFFLE_BATCH = 1 << 18 };
+
 template<typename T> static void
 randShuffle_( Mat& _arr, RNG& rng, double )
 {
     unsigned sz = (unsigned)_arr.total();
+    AutoBuffer<unsigned> _idx(std::min(sz, (unsigned)RAND_SHUFFLE_BATCH));
+    unsigned* idx = _idx.data();
     if( _arr.isContinuous() )
     {
         T* arr = _arr.ptr<T>();
-        for( unsigned i = 0; i < sz; i++ )
+        for( unsigned i0 = 0; i0 < sz; i0 += RAND_SHUFFLE_BATCH )
         {
-            unsigned j = (unsigned)rng % sz;
-            std::swap( arr[j], arr[i] );
+            unsigned n = std::min(sz - i0, (unsigned)RAND_SHUFFLE_BATCH);
+            randIndices_(rng, idx, (int)n, sz);
+            for( unsigned i = 0; i < n; i++ )
+                std::swap( arr[idx[i]], arr[i0 + i] );
         }
     }
     else
@@ -699,12 +962,19 @@ randShuffle_( Mat& _arr, RNG& rng, double )
         size_t step = _arr.step;
         int rows = _arr.rows;
         int cols = _arr.cols;
+        unsigned k = 0, n = 0;
         for( int i0 = 0; i0 < rows; i0++ )
         {
             T* p = _arr.ptr<T>(i0);
             for( int j0 = 0; j0 < cols; j0++ )
             {
-                unsigned k1 = (unsigned)rng % sz;
+                if( k == n )
+                {
+                    n = std::min(sz - ((unsigned)i0*(unsigned)cols + j0), (unsigned)RAND_SHUFFLE_BATCH);
+                    randIndices_(rng, idx, (int)n, sz);
+                    k = 0;
+                }
+                unsigned k1 = idx[k++];
                 int i1 = (int)(k1 / cols);
                 int j1 = (int)(k1 - (unsigned)i1*(unsigned)cols);
                 std::swap( p[j0], ((T*)(data + step*i1))[j1] );
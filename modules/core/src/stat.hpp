@@ -7,6 +7,8 @@
 #define SRC_STAT_HPP
 
 #include "opencv2/core/mat.hpp"
+#include "opencv2/core/utility.hpp"
+#include <vector>
 
 namespace cv {
 
@@ -38,6 +40,77 @@ template <typename T> Scalar ocl_part_sum(Mat m)
 typedef int (*SumFunc)(const uchar*, const uchar* mask, uchar*, int, int);
 SumFunc getSumFunc(int depth);
 
+enum { STAT_PARALLEL_CHUNK_SIZE = 1 << 16 };
+
+// Deterministic parallel reduction for large arrays. The arrays (null-terminated list, src first,
+// empty masks are allowed) are split into chunks of about STAT_PARALLEL_CHUNK_SIZE pixels: ranges
+// of the flattened arrays if they are continuous, or row ranges otherwise. The split depends only
+// on the array geometry, the chunks are reduced in parallel with reduce(chunks, startIdx), where
+// startIdx is the offset of the first chunk pixel in src, and the partial results are combined in
+// the chunk order, so the result doesn't depend on the number of threads.
+// Returns false if the arrays are too small or can't be split; the caller then runs the plain loop.
+template<typename T, typename Reduce, typename Combine> static inline
+bool parallelReduce(const Mat** arrays, T& result, const Reduce& reduce, const Combine& combine)
+{
+    enum { MAX_ARRAYS = 4 };
+    const Mat& src = *arrays[0];
+    size_t total = src.total();
+    if( total < (size_t)STAT_PARALLEL_CHUNK_SIZE*2 )
+        return false;
+
+    int k, narrays = 0;
+    bool continuous = true, is2d = true;
+    for( ; arrays[narrays]; narrays++ )
+    {
+        CV_Assert( narrays < MAX_ARRAYS );
+        const Mat& a = *arrays[narrays];
+        if( a.empty() )
+            continue;
+        CV_Assert( a.size == src.size );
+        continuous = continuous && a.isContinuous();
+        is2d = is2d && a.dims == 2;
+    }
+
+    Mat views[MAX_ARRAYS];
+    bool byRows = !continuous || total > (size_t)INT_MAX;
+    size_t chunkSize = STAT_PARALLEL_CHUNK_SIZE, len = total;
+    if( byRows )
+    {
+        if( !is2d )
+            return false;
+        chunkSize = std::max(chunkSize/src.cols, (size_t)1);
+        len = src.rows;
+    }
+    for( k = 0; k < narrays; k++ )
+    {
+        const Mat& a = *arrays[k];
+        if( !a.empty() )
+            views[k] = byRows ? a : Mat(1, (int)total, a.type(), a.data);
+    }
+
+    size_t nchunks = (len + chunkSize - 1)/chunkSize;
+    if( nchunks < 2 || nchunks > (size_t)INT_MAX )
+        return false;
+
+    std::vector<T> partials(nchunks);
+    parallel_for_(Range(0, (int)nchunks), [&](const Range& r)
+    {
+        Mat chunks[MAX_ARRAYS];
+        for( int i = r.start; i < r.end; i++ )
+        {
+            int start = (int)(i*chunkSize), end = (int)std::min(start + chunkSize, len);
+            for( int j = 0; j < narrays; j++ )
+                if( !views[j].empty() )
+                    chunks[j] = byRows ? views[j].rowRange(start, end) : views[j].colRange(start, end);
+            partials[i] = reduce((const Mat*)chunks, byRows ? (size_t)start*src.cols : (size_t)start);
+        }
+    });
+
+    for( size_t i = 0; i < nchunks; i++ )
+        combine(result, partials[i]);
+    return true;
+}
+
 }
 
 #endif // SRC_STAT_HPP
@@ -181,23 +181,8 @@ static bool ipp_sum(Mat &src, Scalar &_res)
 }
 #endif
 
-Scalar sum(InputArray _src)
+static Scalar sum_(const Mat& src)
 {
-    CV_INSTRUMENT_REGION();
-
-#if defined HAVE_OPENCL || defined HAVE_IPP
-    Scalar _res;
-#endif
-
-#ifdef HAVE_OPENCL
-    CV_OCL_RUN_(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2,
-                ocl_sum(_src, _res, OCL_OP_SUM),
-                _res)
-#endif
-
-    Mat src = _src.getMat();
-    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_sum(src, _res), _res);
-
     int k, cn = src.channels(), depth = src.depth();
     SumFunc func = getSumFunc(depth);
     CV_Assert( cn <= 4 && func != 0 );
@@ -247,4 +232,30 @@ Scalar sum(InputArray _src)
     return s;
 }
 
+Scalar sum(InputArray _src)
+{
+    CV_INSTRUMENT_REGION();
+
+#if defined HAVE_OPENCL || defined HAVE_IPP
+    Scalar _res;
+#endif
+
+#ifdef HAVE_OPENCL
+    CV_OCL_RUN_(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2,
+                ocl_sum(_src, _res, OCL_OP_SUM),
+                _res)
+#endif
+
+    Mat src = _src.getMat();
+    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_sum(src, _res), _res);
+
+    Scalar s;
+    const Mat* arrays[] = {&src, 0};
+    if( parallelReduce(arrays, s,
+                       [](const Mat* chunks, size_t) { return sum_(chunks[0]); },
+                       [](Scalar& a, const Scalar& b) { a += b; }) )
+        return s;
+    return sum_(src);
+}
+
 } // namespace
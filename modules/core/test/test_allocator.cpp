@@ -2,6 +2,9 @@
 // It is subject to the license terms in the LICENSE file found in the top-level directory
 // of this distribution and at http://opencv.org/license.html.
 #include "test_precomp.hpp"
+#include "opencv2/core/utils/arena_allocator.hpp"
+
+#include <thread>
 
 namespace opencv_test { namespace {
 
@@ -141,4 +144,119 @@ TEST_F(AllocatorTest, DummyAllocator)
     EXPECT_EQ(2, DummyAllocator::deallocations);
 }
 
+TEST(Core_ArenaAllocator, reuse_buffers)
+{
+    Ptr<utils::ArenaMatAllocator> arena = utils::ArenaMatAllocator::create();
+    const utils::AllocatorStatisticsInterface& stats = arena->getStatistics();
+    uchar* data = NULL;
+    {
+        utils::MatAllocatorScope scope(arena.get());
+        for (int i = 0; i < 10; i++)
+        {
+            Mat m(480, 640 + i % 2, CV_8UC3);  // the same size class
+            EXPECT_EQ(arena.get(), m.allocator);
+            if (i == 0)
+                data = m.data;
+            EXPECT_EQ(data, m.data);
+        }
+        EXPECT_EQ(0u, stats.getCurrentUsage());
+        EXPECT_EQ(1u, stats.getNumberOfPoolMisses());
+        EXPECT_EQ(9u, stats.getNumberOfPoolHits());
+        EXPECT_EQ(10u, stats.getNumberOfAllocations());
+        EXPECT_GE(arena->getReservedSize(), (size_t)480 * 641 * 3);
+    }
+    Mat m(480, 640, CV_8UC3);
+    EXPECT_EQ(Mat::getDefaultAllocator(), m.allocator);
+    EXPECT_NE(arena.get(), m.allocator);
+
+    arena->freeAllReservedBuffers();
+    EXPECT_EQ(0u, arena->getReservedSize());
+}
+
+TEST(Core_ArenaAllocator, max_reserved_size)
+{
+    utils::ArenaMatAllocator::Params params;
+    params.maxReservedSize = 1 << 20;
+    params.prefault = true;
+    Ptr<utils::ArenaMatAllocator> arena = utils::ArenaMatAllocator::create(params);
+    {
+        utils::MatAllocatorScope scope(arena.get());
+        Mat small(100, 100, CV_8UC1), large(1024, 1024, CV_32FC1);
+        EXPECT_EQ(arena.get(), small.allocator);
+        EXPECT_EQ(arena.get(), large.allocator);
+    }
+    EXPECT_LE(arena->getReservedSize(), params.maxReservedSize);
+    EXPECT_GE(arena->getReservedSize(), (size_t)100 * 100);
+    EXPECT_EQ(0u, arena->getStatistics().getCurrentUsage());
+}
+
+TEST(Core_ArenaAllocator, scope_is_thread_local)
+{
+    Ptr<utils::ArenaMatAllocator> arena = utils::ArenaMatAllocator::create();
+    utils::MatAllocatorScope scope(arena.get());
+    {
+        utils::MatAllocatorScope nested(Mat::getStdAllocator());
+        Mat m(10, 10, CV_8UC1);
+        EXPECT_EQ(Mat::getStdAllocator(), m.allocator);
+    }
+    Mat m(10, 10, CV_8UC1);
+    EXPECT_EQ(arena.get(), m.allocator);
+
+    MatAllocator* other_thread_allocator = NULL;
+    std::thread t([&]() {
+        Mat m2(10, 10, CV_8UC1);
+        other_thread_allocator = m2.allocator;
+    });
+    t.join();
+    EXPECT_NE(arena.get(), other_thread_allocator);
+}
+
+TEST(Core_BufferPool, cpu_controller)
+{
+    utils::ArenaMatAllocator::Params params;
+    params.maxReservedSize = 1 << 20;
+    Ptr<utils::ArenaMatAllocator> arena = utils::ArenaMatAllocator::create(params);
+    BufferPoolController* c = arena->getBufferPoolController();
+    ASSERT_TRUE(c != NULL);
+    EXPECT_EQ(params.maxReservedSize, c->getMaxReservedSize());
+    {
+        Mat a, b;
+        a.allocator = b.allocator = arena.get();
+        a.create(100, 100, CV_8UC1);
+        b.create(64, 64, CV_32FC1);
+    }
+    EXPECT_GE(c->getReservedSize(), (size_t)(100 * 100 + 64 * 64 * 4));
+
+    c->setMaxReservedSize(64 * 64 * 4 * 8 - 1);  // 'b' buffer is too large for this limit
+    EXPECT_LE(c->getReservedSize(), (size_t)(100 * 100 + 4096));
+    EXPECT_GT(c->getReservedSize(), 0u);
+
+    c->freeAllReservedBuffers();
+    EXPECT_EQ(0u, c->getReservedSize());
+    EXPECT_EQ(0u, arena->getReservedSize());
+}
+
+TEST(Core_BufferPool, cpu_default_pool)
+{
+    MatAllocator* allocator = Mat::getBufferPoolAllocator();
+    ASSERT_TRUE(allocator != NULL);
+    EXPECT_EQ(allocator, Mat::getBufferPoolAllocator());
+    BufferPoolController* c = allocator->getBufferPoolController("CPU");
+    ASSERT_TRUE(c != NULL);
+    c->freeAllReservedBuffers();
+    uchar* data = NULL;
+    for (int i = 0; i < 5; i++)
+    {
+        Mat m;
+        m.allocator = allocator;
+        m.create(120, 160, CV_8UC3);
+        if (i == 0)
+            data = m.data;
+        EXPECT_EQ(data, m.data);  // steady state: the buffer is reused
+    }
+    EXPECT_GE(c->getReservedSize(), (size_t)120 * 160 * 3);
+    c->freeAllReservedBuffers();
+    EXPECT_EQ(0u, c->getReservedSize());
+}
+
 }} // namespace
@@ -2387,6 +2387,64 @@ INSTANTIATE_TEST_CASE_P(Arithm, TransposeND, testing::Combine(
     testing::Values(perf::MatType(CV_8UC1), CV_32FC1)
 ));
 
+typedef testing::TestWithParam< tuple<perf::MatType, bool> > Core_Transform_Large;
+
+TEST_P(Core_Transform_Large, transpose_flip_rotate)
+{
+    const int type = get<0>(GetParam());
+    const bool roi = get<1>(GetParam());
+
+    Mat big(1100, 900, type), bigSq(840, 840, type);
+    Mat big1 = big.reshape(1), bigSq1 = bigSq.reshape(1);
+    randu(big1, -100, 100);
+    randu(bigSq1, -100, 100);
+    Mat src = roi ? big(Rect(3, 5, 887, 1031)) : big;
+    Mat sq = roi ? bigSq(Rect(1, 2, 837, 837)) : bigSq;
+
+    int nthreads = getNumThreads();
+    for (int k = 0; k < 2; k++)
+    {
+        setNumThreads(k == 0 ? 1 : 4);
+        Mat dst, ref;
+
+        cv::transpose(src, dst);
+        cvtest::transpose(src, ref);
+        EXPECT_EQ(0, cvtest::norm(dst.reshape(1), ref.reshape(1), NORM_INF));
+
+        for (int code = -1; code <= 1; code++)
+        {
+            cv::flip(src, dst, code);
+            reference::flip(src, ref, code);
+            EXPECT_EQ(0, cvtest::norm(dst.reshape(1), ref.reshape(1), NORM_INF)) << code;
+
+            dst = src.clone();
+            cv::flip(dst, dst, code);
+            EXPECT_EQ(0, cvtest::norm(dst.reshape(1), ref.reshape(1), NORM_INF)) << "inplace " << code;
+        }
+
+        for (int code = ROTATE_90_CLOCKWISE; code <= ROTATE_90_COUNTERCLOCKWISE; code++)
+        {
+            cv::rotate(src, dst, code);
+            reference::rotate(src, ref, code);
+            EXPECT_EQ(0, cvtest::norm(dst.reshape(1), ref.reshape(1), NORM_INF)) << code;
+        }
+
+        Mat sqCopy = sq.clone();
+        cvtest::transpose(sqCopy, ref);
+        cv::transpose(sq, sq);
+        EXPECT_EQ(0, cvtest::norm(sq.reshape(1), ref.reshape(1), NORM_INF)) << "inplace";
+        cv::transpose(sq, sq);
+        EXPECT_EQ(0, cvtest::norm(sq.reshape(1), sqCopy.reshape(1), NORM_INF)) << "inplace twice";
+    }
+    setNumThreads(nthreads);
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Core_Transform_Large, testing::Combine(
+    testing::Values(perf::MatType(CV_8UC1), CV_8UC3, CV_16UC1, CV_16SC2, CV_32FC1, CV_32SC3,
+                    CV_64FC1, CV_8UC(5), CV_64FC4),
+    testing::Bool()
+));
+
 class FlipND : public testing::TestWithParam< tuple<std::vector<int>, perf::MatType> >
 {
 public:
@@ -3019,6 +3077,152 @@ TEST(Core_MinMaxIdx, rows_overflow)
     }
 }
 
+typedef testing::TestWithParam<tuple<int, bool> > Core_Stat_Parallel;
+
+TEST_P(Core_Stat_Parallel, thread_count_independence)
+{
+    const int type = get<0>(GetParam());
+    const bool roi = get<1>(GetParam());
+    const int cn = CV_MAT_CN(type);
+
+    RNG& rng = theRNG();
+    Mat big(1100, 1300, type), big2(big.size(), type), bigMask(big.size(), CV_8U);
+    rng.fill(big, RNG::UNIFORM, -100, 100);
+    rng.fill(big2, RNG::UNIFORM, -100, 100);
+    rng.fill(bigMask, RNG::UNIFORM, 0, 2);
+    big.rowRange(0, 50).setTo(Scalar::all(0));
+    Rect r = roi ? Rect(3, 5, 1280, 1000) : Rect(0, 0, big.cols, big.rows);
+    Mat src = big(r), src2 = big2(r), mask = bigMask(r);
+
+    struct Results
+    {
+        Scalar sum, mean, meanMasked, mu, sigma;
+        double norms[6];
+        double minVal, maxVal;
+        Point minLoc, maxLoc;
+        int nz;
+        bool hasNz;
+    } res[2];
+
+    int nthreads = getNumThreads();
+    for (int k = 0; k < 2; k++)
+    {
+        setNumThreads(k == 0 ? 1 : 4);
+        Results& rs = res[k];
+        rs.sum = cv::sum(src);
+        rs.mean = cv::mean(src);
+        rs.meanMasked = cv::mean(src, mask);
+        cv::meanStdDev(src, rs.mu, rs.sigma, mask);
+        rs.norms[0] = cv::norm(src, NORM_INF);
+        rs.norms[1] = cv::norm(src, NORM_L1, mask);
+        rs.norms[2] = cv::norm(src, NORM_L2);
+        rs.norms[3] = cv::norm(src, src2, NORM_INF, mask);
+        rs.norms[4] = cv::norm(src, src2, NORM_L1);
+        rs.norms[5] = cv::norm(src, src2, NORM_L2SQR);
+        rs.minLoc = rs.maxLoc = Point(-1, -1);
+        rs.nz = -1;
+        rs.hasNz = false;
+        if (cn == 1)
+        {
+            cv::minMaxLoc(src, &rs.minVal, &rs.maxVal, &rs.minLoc, &rs.maxLoc, mask);
+            rs.nz = cv::countNonZero(src);
+            rs.hasNz = cv::hasNonZero(src);
+        }
+        else
+            cv::minMaxIdx(src, &rs.minVal, &rs.maxVal);
+    }
+    setNumThreads(nthreads);
+
+    for (int c = 0; c < 4; c++)
+    {
+        EXPECT_EQ(res[0].sum[c], res[1].sum[c]) << c;
+        EXPECT_EQ(res[0].mean[c], res[1].mean[c]) << c;
+        EXPECT_EQ(res[0].meanMasked[c], res[1].meanMasked[c]) << c;
+        EXPECT_EQ(res[0].mu[c], res[1].mu[c]) << c;
+        EXPECT_EQ(res[0].sigma[c], res[1].sigma[c]) << c;
+        EXPECT_NEAR(res[1].meanMasked[c], res[1].mu[c], 1e-6) << c;
+    }
+    for (int i = 0; i < 6; i++)
+        EXPECT_EQ(res[0].norms[i], res[1].norms[i]) << i;
+    EXPECT_EQ(res[0].minVal, res[1].minVal);
+    EXPECT_EQ(res[0].maxVal, res[1].maxVal);
+    EXPECT_EQ(res[0].minLoc, res[1].minLoc);
+    EXPECT_EQ(res[0].maxLoc, res[1].maxLoc);
+    EXPECT_EQ(res[0].nz, res[1].nz);
+    EXPECT_EQ(res[0].hasNz, res[1].hasNz);
+
+    // the chunked results still match a plain reference
+    Mat src64;
+    src.convertTo(src64, CV_64F);
+    double sum0 = 0, maxAbs = 0;
+    int nz0 = 0;
+    for (int y = 0; y < src64.rows; y++)
+    {
+        const double* row = src64.ptr<double>(y);
+        for (int x = 0; x < src64.cols*cn; x++)
+        {
+            sum0 += row[x];
+            maxAbs = std::max(maxAbs, std::abs(row[x]));
+            nz0 += row[x] != 0;
+        }
+    }
+    double sumAll = 0;
+    for (int c = 0; c < cn; c++)
+        sumAll += res[1].sum[c];
+    EXPECT_NEAR(sum0, sumAll, 1e-6*src.total()*100);
+    EXPECT_EQ(maxAbs, res[1].norms[0]);
+    if (cn == 1)
+    {
+        EXPECT_EQ(nz0, res[1].nz);
+        EXPECT_TRUE(res[1].hasNz);
+        double minVal0 = 0, maxVal0 = 0;
+        Point minLoc0, maxLoc0;
+        minMaxLoc(src64, &minVal0, &maxVal0, &minLoc0, &maxLoc0, mask);
+        EXPECT_EQ(minVal0, res[1].minVal);
+        EXPECT_EQ(maxVal0, res[1].maxVal);
+        EXPECT_EQ(minLoc0, res[1].minLoc);
+        EXPECT_EQ(maxLoc0, res[1].maxLoc);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Core_Stat_Parallel, testing::Combine(
+    testing::Values(CV_8UC1, CV_16SC1, CV_32SC1, CV_32FC1, CV_64FC1, CV_8UC3, CV_32FC4),
+    testing::Bool()
+));
+
+TEST(Core_Stat_ParallelND, thread_count_independence)
+{
+    int sz[] = {20, 100, 120};
+    Mat src(3, sz, CV_32F);
+    randu(src, -1, 1);
+    src.at<float>(7, 50, 60) = 5.f;
+    src.at<float>(13, 1, 2) = -5.f;
+
+    int nthreads = getNumThreads();
+    double s[2], l2[2], minVal[2], maxVal[2];
+    int minIdx[2][3], maxIdx[2][3];
+    for (int k = 0; k < 2; k++)
+    {
+        setNumThreads(k == 0 ? 1 : 4);
+        s[k] = cv::sum(src)[0];
+        l2[k] = cv::norm(src, NORM_L2);
+        cv::minMaxIdx(src, &minVal[k], &maxVal[k], minIdx[k], maxIdx[k]);
+    }
+    setNumThreads(nthreads);
+
+    EXPECT_EQ(s[0], s[1]);
+    EXPECT_EQ(l2[0], l2[1]);
+    EXPECT_EQ(-5., minVal[1]);
+    EXPECT_EQ(5., maxVal[1]);
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(minIdx[0][i], minIdx[1][i]);
+        EXPECT_EQ(maxIdx[0][i], maxIdx[1][i]);
+    }
+    EXPECT_EQ(13, minIdx[1][0]); EXPECT_EQ(1, minIdx[1][1]); EXPECT_EQ(2, minIdx[1][2]);
+    EXPECT_EQ(7, maxIdx[1][0]); EXPECT_EQ(50, maxIdx[1][1]); EXPECT_EQ(60, maxIdx[1][2]);
+}
+
 TEST(Core_Magnitude, regression_19506)
 {
     for (int N = 1; N <= 64; ++N)
@@ -983,4 +983,160 @@ protected:
 TEST(Core_DFT, reverse) { Core_DXTReverseTest test(Core_DXTReverseTest::ModeDFT); test.safe_run(); }
 TEST(Core_DCT, reverse) { Core_DXTReverseTest test(Core_DXTReverseTest::ModeDCT); test.safe_run(); }
 
+typedef testing::TestWithParam<tuple<int, int> > Core_DFTPlan;
+
+TEST_P(Core_DFTPlan, accuracy)
+{
+    const int type = get<0>(GetParam());
+    const int flags = get<1>(GetParam());
+    RNG& rng = theRNG();
+
+    const Size sizes[] = { Size(64, 48), Size(45, 33), Size(1, 30), Size(17, 1) };
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++)
+    {
+        Size sz = sizes[k];
+        SCOPED_TRACE(cv::format("size=%dx%d", sz.width, sz.height));
+        if ((flags & DFT_INVERSE) && CV_MAT_CN(type) == 1 && (sz.width == 1 || sz.height == 1))
+            continue;
+        Mat big(sz.height + 2, sz.width + 3, type);
+        rng.fill(big, RNG::UNIFORM, -1, 1);
+        Mat src = big(Rect(1, 2, sz.width, sz.height)), src_c = src.clone();
+
+        Ptr<DFTPlan> plan = DFTPlan::create(sz, type, flags);
+        ASSERT_FALSE(plan.empty());
+
+        // non-continuous, continuous and in-place transforms give the same results as dft()
+        Mat ref, dst;
+        dft(src, ref, flags);
+        EXPECT_EQ(ref.type(), plan->dstType());
+        plan->execute(src, dst);
+        EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), 0.0);
+        dft(src_c, ref, flags);
+        plan->execute(src_c, dst);
+        EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), 0.0);
+        if (plan->dstType() == type)
+        {
+            Mat inplace = src_c.clone();
+            ref = src_c.clone();
+            dft(ref, ref, flags);
+            plan->execute(inplace, inplace);
+            EXPECT_LE(cvtest::norm(ref, inplace, NORM_INF), 0.0);
+        }
+
+        // the same plan is returned for the same parameters
+        EXPECT_EQ(plan.get(), DFTPlan::create(sz, type, flags).get());
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Core_DFTPlan, testing::Combine(
+    testing::Values(CV_32FC1, CV_32FC2, CV_64FC1, CV_64FC2),
+    testing::Values(0, (int)DFT_INVERSE, (int)DFT_ROWS, (int)DFT_SCALE, (int)DFT_COMPLEX_OUTPUT,
+                    (int)(DFT_INVERSE | DFT_REAL_OUTPUT | DFT_SCALE))));
+
+TEST(Core_DFT, plan_batch)
+{
+    const Size sz(40, 30);
+    Ptr<DFTPlan> plan = DFTPlan::create(sz, CV_32FC1, DFT_COMPLEX_OUTPUT);
+    std::vector<Mat> src(37), dst;
+    for (size_t i = 0; i < src.size(); i++)
+    {
+        src[i].create(sz, CV_32FC1);
+        randu(src[i], -1, 1);
+    }
+    plan->executeBatch(src, dst);
+    ASSERT_EQ(src.size(), dst.size());
+    for (size_t i = 0; i < src.size(); i++)
+    {
+        Mat ref;
+        dft(src[i], ref, DFT_COMPLEX_OUTPUT);
+        EXPECT_LE(cvtest::norm(ref, dst[i], NORM_INF), 0.0) << i;
+    }
+
+    // concurrent use of the plan
+    std::vector<Mat> results(src.size());
+    parallel_for_(Range(0, (int)src.size()), [&](const Range& r)
+    {
+        for (int i = r.start; i < r.end; i++)
+            plan->execute(src[i], results[i]);
+    });
+    for (size_t i = 0; i < src.size(); i++)
+        EXPECT_LE(cvtest::norm(dst[i], results[i], NORM_INF), 0.0) << i;
+}
+
+TEST(Core_DFT, batch_3d)
+{
+    const int count = 19, rows = 16, cols = 24;
+    const int sz[] = { count, rows, cols };
+    for (int flags = 0; flags <= (int)(DFT_INVERSE | DFT_SCALE); flags += (int)DFT_INVERSE)
+    {
+        SCOPED_TRACE(flags);
+        Mat src(3, sz, CV_32FC2), dst;
+        randu(src, -1, 1);
+        dftBatch(src, dst, flags);
+        ASSERT_EQ(3, dst.dims);
+        ASSERT_EQ(src.type(), dst.type());
+        for (int i = 0; i < count; i++)
+        {
+            Mat ref;
+            dft(Mat(rows, cols, CV_32FC2, src.ptr(i)), ref, flags);
+            EXPECT_LE(cvtest::norm(ref, Mat(rows, cols, CV_32FC2, dst.ptr(i)), NORM_INF), 0.0) << i;
+        }
+
+        // in-place
+        dftBatch(src, src, flags);
+        EXPECT_LE(cvtest::norm(dst, src, NORM_INF), 0.0);
+    }
+
+    Mat real(3, sz, CV_64FC1), dst;
+    randu(real, -1, 1);
+    dftBatch(real, dst, DFT_COMPLEX_OUTPUT);
+    ASSERT_EQ(CV_64FC2, dst.type());
+    for (int i = 0; i < count; i++)
+    {
+        Mat ref;
+        dft(Mat(rows, cols, CV_64FC1, real.ptr(i)), ref, DFT_COMPLEX_OUTPUT);
+        EXPECT_LE(cvtest::norm(ref, Mat(rows, cols, CV_64FC2, dst.ptr(i)), NORM_INF), 0.0) << i;
+    }
+
+    std::vector<Mat> empty, empty_dst;
+    EXPECT_NO_THROW(dftBatch(empty, empty_dst));
+    EXPECT_TRUE(empty_dst.empty());
+}
+
+// forward transform of real arrays (packed real FFT) against transform of complex arrays
+TEST(Core_DFT, real_input_sizes)
+{
+    RNG& rng = theRNG();
+    for (int depth = CV_32F; depth <= CV_64F; depth++)
+    {
+        for (int n = 1; n <= 160; n++)
+        {
+            SCOPED_TRACE(cv::format("depth=%d n=%d", depth, n));
+            Mat src(3, n, CV_MAKETYPE(depth, 1)), dst, ref;
+            rng.fill(src, RNG::UNIFORM, -1, 1);
+            Mat planes[] = { src, Mat::zeros(src.size(), src.type()) }, csrc;
+            merge(planes, 2, csrc);
+
+            dft(src, dst, DFT_ROWS | DFT_COMPLEX_OUTPUT);
+            dft(csrc, ref, DFT_ROWS);
+            EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), depth == CV_32F ? 1e-4 : 1e-10);
+
+            dft(src, dst, DFT_ROWS | DFT_SCALE);
+            Mat back;
+            dft(dst, back, DFT_ROWS | DFT_INVERSE);
+            EXPECT_LE(cvtest::norm(src, back, NORM_INF), depth == CV_32F ? 1e-5 : 1e-12);
+        }
+    }
+}
+
+TEST(Core_DFT, plan_invalid_args)
+{
+    EXPECT_THROW(DFTPlan::create(Size(10, 10), CV_8UC1), cv::Exception);
+    EXPECT_THROW(DFTPlan::create(Size(10, 10), CV_32FC1, DFT_COMPLEX_INPUT), cv::Exception);
+    Ptr<DFTPlan> plan = DFTPlan::create(Size(10, 10), CV_32FC1);
+    Mat dst;
+    EXPECT_THROW(plan->execute(Mat(10, 12, CV_32FC1, Scalar::all(0)), dst), cv::Exception);
+    EXPECT_THROW(plan->execute(Mat(10, 10, CV_64FC1, Scalar::all(0)), dst), cv::Exception);
+}
+
 }} // namespace
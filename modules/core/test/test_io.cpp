@@ -1985,6 +1985,261 @@ INSTANTIATE_TEST_CASE_P( /*nothing*/,
     Core_InputOutput_regression_25073,
     Values("test.json", "test.xml", "test.yml") );
 
+typedef testing::TestWithParam< std::string > Core_InputOutput_lazy;
+
+TEST_P(Core_InputOutput_lazy, base64_payloads)
+{
+    const std::string fname = cv::tempfile(GetParam().c_str());
+    RNG& rng = theRNG();
+    Mat m32f(200, 100, CV_32FC3), m8u(3001, 7, CV_8UC1), m64f(3, 4, CV_64FC1);
+    rng.fill(m32f, RNG::UNIFORM, -100, 100);
+    rng.fill(m8u, RNG::UNIFORM, 0, 256);
+    rng.fill(m64f, RNG::UNIFORM, -1, 1);
+    std::vector<int> vec(5000);
+    for (size_t i = 0; i < vec.size(); i++)
+        vec[i] = (int)i * 3 - 100;
+    {
+        FileStorage fs(fname, FileStorage::WRITE_BASE64);
+        fs << "m32f" << m32f << "m8u" << m8u << "m64f" << m64f << "vec" << vec << "value" << 5;
+    }
+
+    FileStorage fs_ref(fname, FileStorage::READ);
+    FileStorage fs(fname, FileStorage::READ + FileStorage::LAZY);
+    ASSERT_TRUE(fs.isOpened());
+
+    Mat m;
+    fs["m32f"] >> m;
+    EXPECT_MAT_NEAR(m32f, m, 0);
+    fs["m8u"] >> m;
+    EXPECT_MAT_NEAR(m8u, m, 0);
+    fs["m64f"] >> m;
+    EXPECT_MAT_NEAR(m64f, m, 0);
+    std::vector<int> vec_result;
+    fs["vec"] >> vec_result;
+    EXPECT_EQ(vec, vec_result);
+    EXPECT_EQ(5, (int)fs["value"]);
+
+    // element access and iteration over the deferred payload
+    FileNode data = fs["m32f"]["data"], data_ref = fs_ref["m32f"]["data"];
+    ASSERT_TRUE(data.isSeq());
+    ASSERT_EQ(data_ref.size(), data.size());
+    EXPECT_EQ((float)data_ref[1000], (float)data[1000]);
+    EXPECT_EQ((float)data_ref[7], (float)data[7]);
+    size_t n = 0;
+    for (FileNodeIterator it = data.begin(), it_ref = data_ref.begin(); it != data.end(); ++it, ++it_ref, n++)
+        ASSERT_EQ((float)*it_ref, (float)*it) << n;
+    EXPECT_EQ(data.size(), n);
+
+    // partial reads continue from the current position
+    FileNode bytes = fs["m8u"]["data"];
+    FileNodeIterator it = bytes.begin();
+    uchar buf[5] = {0};
+    it.readRaw("u", buf, sizeof(buf));
+    EXPECT_EQ(bytes.size() - sizeof(buf), it.remaining());
+    for (int i = 0; i < 5; i++, ++it)
+    {
+        EXPECT_EQ(m8u.at<uchar>(i), buf[i]);
+        EXPECT_EQ((int)m8u.at<uchar>((int)sizeof(buf) + i), (int)*it);
+    }
+    std::vector<float> rest(4);
+    it.readRaw("f", &rest[0], rest.size() * sizeof(float));
+    for (int i = 0; i < 4; i++)
+        EXPECT_EQ((float)m8u.at<uchar>(10 + i), rest[i]);
+
+    fs.release();
+    fs_ref.release();
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
+INSTANTIATE_TEST_CASE_P( /*nothing*/,
+    Core_InputOutput_lazy,
+    Values(".yml", ".xml", ".json") );
+
+typedef testing::TestWithParam< std::string > Core_InputOutput_base64;
+
+static std::string referenceBase64(const std::vector<uchar>& data)
+{
+    static const char tab[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string result;
+    for (size_t i = 0; i < data.size(); i += 3)
+    {
+        unsigned v = data[i] << 16;
+        if (i + 1 < data.size()) v |= data[i + 1] << 8;
+        if (i + 2 < data.size()) v |= data[i + 2];
+        result += tab[(v >> 18) & 63];
+        result += tab[(v >> 12) & 63];
+        result += i + 1 < data.size() ? tab[(v >> 6) & 63] : '=';
+        result += i + 2 < data.size() ? tab[v & 63] : '=';
+    }
+    return result;
+}
+
+TEST_P(Core_InputOutput_base64, large_data)
+{
+    const std::string ext = GetParam();
+    RNG& rng = theRNG();
+    // large enough to be processed by several threads, sizes are not multiples of vector size
+    Mat m8u(1001, 503, CV_8UC1), m32f(37, 29, CV_32FC3);
+    rng.fill(m8u, RNG::UNIFORM, 0, 256);
+    rng.fill(m32f, RNG::UNIFORM, -100, 100);
+    std::vector<uchar> bytes(100000 + 1);
+    for (size_t i = 0; i < bytes.size(); i++)
+        bytes[i] = (uchar)(i * 7 + i / 256);
+
+    std::string content;
+    {
+        FileStorage fs(ext, FileStorage::WRITE_BASE64 + FileStorage::MEMORY);
+        fs << "m8u" << m8u << "m32f" << m32f;
+        fs << "bytes" << "[";
+        fs.writeRaw("u", &bytes[0], bytes.size());
+        fs << "]";
+        content = fs.releaseAndGetString();
+    }
+
+    // compare with a straightforward encoder
+    std::string text;
+    for (size_t i = 0; i < content.size(); i++)
+        if (!isspace((uchar)content[i]))
+            text += content[i];
+    std::vector<uchar> expected(24, (uchar)' '); // header with the format of elements
+    expected[0] = 'u';
+    expected.insert(expected.end(), bytes.begin(), bytes.end());
+    EXPECT_NE(std::string::npos, text.find(referenceBase64(expected)));
+
+    for (int lazy = 0; lazy < 2; lazy++)
+    {
+        SCOPED_TRACE(lazy ? "lazy" : "regular");
+        FileStorage fs(content, FileStorage::READ + FileStorage::MEMORY + (lazy ? FileStorage::LAZY : 0));
+        ASSERT_TRUE(fs.isOpened());
+        Mat m;
+        fs["m8u"] >> m;
+        EXPECT_MAT_NEAR(m8u, m, 0);
+        fs["m32f"] >> m;
+        EXPECT_MAT_NEAR(m32f, m, 0);
+        std::vector<uchar> bytes_result;
+        fs["bytes"] >> bytes_result;
+        EXPECT_EQ(bytes, bytes_result);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P( /*nothing*/,
+    Core_InputOutput_base64,
+    Values(".yml", ".xml", ".json") );
+
+TEST(Core_InputOutput_binary, roundtrip)
+{
+    const std::string fname = cv::tempfile(".bin");
+    RNG& rng = theRNG();
+    Mat m32f(200, 100, CV_32FC3), m16s(31, 17, CV_16SC2), big(300, 400, CV_8UC1);
+    rng.fill(m32f, RNG::UNIFORM, -100, 100);
+    rng.fill(m16s, RNG::UNIFORM, -1000, 1000);
+    rng.fill(big, RNG::UNIFORM, 0, 256);
+    Mat roi = big(Rect(10, 20, 101, 53));
+    int nd_sizes[] = { 3, 4, 5 };
+    Mat nd(3, nd_sizes, CV_64FC1);
+    rng.fill(nd, RNG::UNIFORM, -1, 1);
+    std::vector<int> vec(1000);
+    for (size_t i = 0; i < vec.size(); i++)
+        vec[i] = (int)i * 3 - 100;
+    std::vector<KeyPoint> kpts;
+    kpts.push_back(KeyPoint(1.5f, 2.5f, 3.f, 45.f, 0.5f, 1, -1));
+    kpts.push_back(KeyPoint(10.f, 20.f, 7.f, -1.f, 0.25f, 2, 3));
+    const int ints[] = { 1, 2, 3 };
+    {
+        FileStorage fs(fname, FileStorage::WRITE + FileStorage::FORMAT_BINARY);
+        ASSERT_TRUE(fs.isOpened());
+        fs << "int_value" << 5 << "real_value" << 0.125 << "str_value" << "some text";
+        fs << "m32f" << m32f << "m16s" << m16s << "roi" << roi << "nd" << nd;
+        fs << "vec" << vec << "kpts" << kpts;
+        fs << "nested" << "{" << "seq" << "[" << 1 << "{:" << "x" << 3 << "}" << "]" << "}";
+        // raw data mixed with other elements of the sequence
+        fs << "mixed1" << "[";
+        fs.writeRaw("i", ints, sizeof(ints));
+        fs << 4 << "]";
+        fs << "mixed2" << "[" << 0;
+        fs.writeRaw("i", ints, sizeof(ints));
+        fs << "]";
+    }
+
+    FileStorage fs(fname, FileStorage::READ);
+    ASSERT_TRUE(fs.isOpened());
+    EXPECT_EQ(FileStorage::FORMAT_BINARY, fs.getFormat());
+    EXPECT_EQ(5, (int)fs["int_value"]);
+    EXPECT_EQ(0.125, (double)fs["real_value"]);
+    EXPECT_EQ("some text", (std::string)fs["str_value"]);
+
+    Mat m;
+    fs["m32f"] >> m;
+    EXPECT_MAT_NEAR(m32f, m, 0);
+    EXPECT_EQ(0u, (size_t)m.data % 64);
+    fs["m16s"] >> m;
+    EXPECT_MAT_NEAR(m16s, m, 0);
+    fs["roi"] >> m;
+    EXPECT_MAT_NEAR(roi, m, 0);
+    fs["nd"] >> m;
+    ASSERT_EQ(3, m.dims);
+    EXPECT_EQ(0, cvtest::norm(nd, m, NORM_INF));
+    std::vector<int> vec_result;
+    fs["vec"] >> vec_result;
+    EXPECT_EQ(vec, vec_result);
+    std::vector<KeyPoint> kpts_result;
+    fs["kpts"] >> kpts_result;
+    ASSERT_EQ(kpts.size(), kpts_result.size());
+    for (size_t i = 0; i < kpts.size(); i++)
+    {
+        EXPECT_EQ(kpts[i].pt, kpts_result[i].pt);
+        EXPECT_EQ(kpts[i].size, kpts_result[i].size);
+        EXPECT_EQ(kpts[i].octave, kpts_result[i].octave);
+        EXPECT_EQ(kpts[i].class_id, kpts_result[i].class_id);
+    }
+
+    FileNode seq = fs["nested"]["seq"];
+    ASSERT_TRUE(seq.isSeq());
+    ASSERT_EQ(2u, seq.size());
+    EXPECT_EQ(1, (int)seq[0]);
+    EXPECT_EQ(3, (int)seq[1]["x"]);
+
+    FileNode mixed1 = fs["mixed1"], mixed2 = fs["mixed2"];
+    ASSERT_EQ(4u, mixed1.size());
+    ASSERT_EQ(4u, mixed2.size());
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(i < 3 ? ints[i] : 4, (int)mixed1[i]);
+        EXPECT_EQ(i > 0 ? ints[i - 1] : 0, (int)mixed2[i]);
+    }
+
+    // element access and iteration over the arrays
+    FileNode data = fs["m32f"]["data"];
+    ASSERT_EQ(m32f.total() * 3, data.size());
+    EXPECT_EQ(m32f.at<Vec3f>(10, 20)[1], (float)data[(10 * 100 + 20) * 3 + 1]);
+    size_t n = 0;
+    for (FileNodeIterator it = fs["vec"].begin(); it != fs["vec"].end(); ++it, n++)
+        ASSERT_EQ(vec[n], (int)*it);
+    EXPECT_EQ(vec.size(), n);
+
+    // the loaded matrix outlives the storage, its modification doesn't affect the file
+    fs["m32f"] >> m;
+    fs.release();
+    EXPECT_MAT_NEAR(m32f, m, 0);
+    m.setTo(Scalar::all(0));
+    m.release();
+    {
+        FileStorage fs2(fname, FileStorage::READ);
+        fs2["m32f"] >> m;
+        EXPECT_MAT_NEAR(m32f, m, 0);
+    }
+    m.release();
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
+TEST(Core_InputOutput_binary, unsupported_modes)
+{
+    const std::string fname = cv::tempfile(".bin");
+    FileStorage fs;
+    EXPECT_THROW(fs.open(fname, FileStorage::WRITE + FileStorage::FORMAT_BINARY + FileStorage::MEMORY), cv::Exception);
+    EXPECT_THROW(fs.open(fname, FileStorage::APPEND + FileStorage::FORMAT_BINARY), cv::Exception);
+}
+
 // see https://github.com/opencv/opencv/issues/25946
 TEST(Core_InputOutput, FileStorage_invalid_attribute_value_regression_25946)
 {
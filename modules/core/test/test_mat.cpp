@@ -491,6 +491,87 @@ TEST(Core_PCA, accuracy)
     EXPECT_EQ(0, remove(filename.c_str()));
 }
 
+// low-rank data with noise and non-zero mean
+static Mat generatePCAData(RNG& rng, int n, int d, int rank)
+{
+    Mat basis(rank, d, CV_32F), coef(n, rank, CV_32F), noise(n, d, CV_32F);
+    rng.fill(basis, RNG::NORMAL, 0, 1);
+    rng.fill(coef, RNG::NORMAL, 0, 1);
+    rng.fill(noise, RNG::NORMAL, 0, 0.1);
+    for (int i = 0; i < rank; i++)
+        coef.col(i) *= rank - i;
+    Mat data = coef * basis + noise;
+    data += Scalar::all(3);
+    return data;
+}
+
+static void checkPCAComponents(const PCA& ref, const PCA& pca, int k, double eps)
+{
+    ASSERT_GE(pca.eigenvectors.rows, k);
+    EXPECT_LE(cvtest::norm(ref.mean, pca.mean, NORM_L2 | NORM_RELATIVE), eps);
+    EXPECT_LE(cvtest::norm(ref.eigenvalues.rowRange(0, k), pca.eigenvalues.rowRange(0, k), NORM_L2 | NORM_RELATIVE), eps);
+    for (int i = 0; i < k; i++)
+    {
+        // both directions v and -v are valid
+        double dot = ref.eigenvectors.row(i).dot(pca.eigenvectors.row(i));
+        EXPECT_NEAR(1.0, std::abs(dot), eps) << "i=" << i;
+    }
+}
+
+TEST(Core_PCA, randomized)
+{
+    RNG rng(12345);
+    const int k = 10;
+    Mat data = generatePCAData(rng, 3000, 200, 20);
+
+    PCA ref(data, noArray(), PCA::DATA_AS_ROW, k);
+    PCA rPCA(data, noArray(), PCA::DATA_AS_ROW | PCA::RANDOMIZED, k);
+    ASSERT_EQ(k, rPCA.eigenvectors.rows);
+    ASSERT_EQ(k, rPCA.eigenvalues.rows);
+    checkPCAComponents(ref, rPCA, k, 1e-4);
+    EXPECT_EQ(3000, rPCA.nsamples);
+
+    PCA cPCA(data.t(), noArray(), PCA::DATA_AS_COL | PCA::RANDOMIZED, k);
+    ASSERT_EQ(Size(1, 200), cPCA.mean.size());
+    EXPECT_LE(cvtest::norm(rPCA.eigenvalues, cPCA.eigenvalues, NORM_L2 | NORM_RELATIVE), 1e-5);
+    EXPECT_LE(cvtest::norm(cv::abs(rPCA.project(data)), cv::abs(cPCA.project(data.t()).t()), NORM_L2 | NORM_RELATIVE), 1e-4);
+
+    Mat data64;
+    data.convertTo(data64, CV_64F);
+    PCA ref64(data64, noArray(), PCA::DATA_AS_ROW, k);
+    PCA dPCA(data64, noArray(), PCA::DATA_AS_ROW | PCA::RANDOMIZED, k);
+    EXPECT_EQ(CV_64F, dPCA.eigenvectors.type());
+    checkPCAComponents(ref64, dPCA, k, 1e-6);
+}
+
+TEST(Core_PCA, update)
+{
+    RNG rng(12345);
+    const int n = 4000, k = 8, batch = 1000;
+    Mat data = generatePCAData(rng, n, 64, 16);
+
+    PCA ref(data, noArray(), PCA::DATA_AS_ROW, k);
+    PCA rPCA, cPCA;
+    for (int i = 0; i < n; i += batch)
+    {
+        rPCA.update(data.rowRange(i, i + batch), PCA::DATA_AS_ROW, 24);
+        cPCA.update(data.rowRange(i, i + batch).t(), PCA::DATA_AS_COL, 24);
+    }
+    EXPECT_EQ(n, rPCA.nsamples);
+    ASSERT_EQ(24, rPCA.eigenvectors.rows);
+    checkPCAComponents(ref, rPCA, k, 1e-4);
+    EXPECT_LE(cvtest::norm(rPCA.eigenvalues, cPCA.eigenvalues, NORM_L2 | NORM_RELATIVE), 1e-5);
+    EXPECT_LE(cvtest::norm(rPCA.mean, cPCA.mean.t(), NORM_L2 | NORM_RELATIVE), 1e-6);
+
+    // continue the model computed by the regular PCA
+    PCA pca(data.rowRange(0, n/2), noArray(), PCA::DATA_AS_ROW, 24);
+    pca.update(data.rowRange(n/2, n));
+    EXPECT_EQ(n, pca.nsamples);
+    checkPCAComponents(ref, pca, k, 1e-4);
+
+    EXPECT_ANY_THROW(pca.update(data.colRange(0, 32)));
+}
+
 class Core_ArrayOpTest : public cvtest::BaseTest
 {
 public:
@@ -2244,6 +2325,82 @@ TEST(Core_MatExpr, issue_16689)
     }
 }
 
+typedef testing::TestWithParam<perf::MatType> Core_MatExpr_Fused;
+
+TEST_P(Core_MatExpr_Fused, accuracy)
+{
+    const int type = GetParam();
+    const int depth = CV_MAT_DEPTH(type);
+    RNG& rng = theRNG();
+    Mat a(37, 53, type), b(37, 53, type), c(37, 53, type), d(37, 53, type);
+    double lo = depth == CV_8U || depth == CV_16U ? 0 : -100, hi = 100;
+    rng.fill(a, RNG::UNIFORM, lo, hi);
+    rng.fill(b, RNG::UNIFORM, lo, hi);
+    rng.fill(c, RNG::UNIFORM, lo, hi);
+    rng.fill(d, RNG::UNIFORM, lo, hi);
+    c.setTo(0, c == 5);  // division by zero
+    const double eps = depth <= CV_32S ? 1 : depth == CV_32F ? 1e-4 : 1e-10;
+
+    // reference: step by step evaluation with temporary matrices
+    Mat t1, t2, t3, ref;
+    cv::subtract(a, b, t1);
+    cv::multiply(t1, c, t2);
+    t2.convertTo(t3, type, 0.5);
+    cv::add(t3, d, ref);
+
+    MatExpr e = (a - b).mul(c) * 0.5 + d;
+    EXPECT_TRUE(e.node != NULL);
+    EXPECT_EQ(type, e.type());
+    EXPECT_EQ(a.size(), e.size());
+    Mat dst = e;
+    EXPECT_LE(cvtest::norm(dst, ref, NORM_INF), eps);
+
+    // ROI of the fused expression
+    Mat roi = e(Range(3, 20), Range(5, 40));
+    EXPECT_LE(cvtest::norm(roi, ref(Range(3, 20), Range(5, 40)), NORM_INF), eps);
+
+    // comparison and division
+    Mat cnt = (a > b) * (1. / 255) + (c > d) * (1. / 255), t5, t6;
+    cv::compare(a, b, t5, CMP_GT);
+    cv::compare(c, d, t6, CMP_GT);
+    cv::addWeighted(t5, 1. / 255, t6, 1. / 255, 0, ref);
+    EXPECT_EQ(0, cvtest::norm(cnt, ref, NORM_INF));
+    Mat q = (a - b) / c * 2;
+    cv::divide(t1, c, t3);
+    t3.convertTo(ref, type, 2);
+    EXPECT_LE(cvtest::norm(q, ref, NORM_INF), eps);
+
+    // saturation to the requested type
+    if (CV_MAT_CN(type) == 1)
+    {
+        Mat_<float> f = (a - b).mul(c);
+        Mat ref_f;
+        t2.convertTo(ref_f, CV_32F);
+        EXPECT_LE(cvtest::norm(f, ref_f, NORM_INF), depth <= CV_32S ? 0 : eps * 1000);
+    }
+
+    // in-place update
+    Mat acc = d.clone();
+    acc += (a - b).mul(c);
+    Mat ref_acc;
+    cv::add(d, t2, ref_acc);
+    EXPECT_LE(cvtest::norm(acc, ref_acc, NORM_INF), eps);
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Core_MatExpr_Fused, testing::Values(CV_8UC1, CV_8UC3, CV_16SC1, CV_16UC4, CV_32SC1, CV_32FC1, CV_32FC2, CV_64FC1));
+
+TEST(Core_MatExpr, fused_saturate_intermediate)
+{
+    Mat a(1, 3, CV_8UC1), b(1, 3, CV_8UC1), c(1, 3, CV_8UC1);
+    a.at<uchar>(0) = 10;  b.at<uchar>(0) = 20;  c.at<uchar>(0) = 3;  // (a - b) is saturated to 0
+    a.at<uchar>(1) = 200; b.at<uchar>(1) = 50;  c.at<uchar>(1) = 2;   // (a - b).mul(c) is saturated to 255
+    a.at<uchar>(2) = 7;   b.at<uchar>(2) = 2;   c.at<uchar>(2) = 0;
+    Mat r = (a - b).mul(c) / c + 1;
+    EXPECT_EQ(1, r.at<uchar>(0));
+    EXPECT_EQ(129, r.at<uchar>(1));
+    EXPECT_EQ(1, r.at<uchar>(2));  // division by zero gives zero
+}
+
 #ifdef HAVE_EIGEN
 TEST(Core_Eigen, eigen2cv_check_Mat_type)
 {
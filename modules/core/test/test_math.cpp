@@ -2788,6 +2788,117 @@ TEST(Core_SVD, flt)
     EXPECT_LE(cvtest::norm(B1, B, NORM_L2 + NORM_RELATIVE), FLT_EPSILON*10);
 }
 
+TEST(Core_SVD, large)
+{
+    RNG& rng = cvtest::TS::ptr()->get_rng();
+    for (int depth = CV_32F; depth <= CV_64F; depth++)
+    {
+        const double eps = depth == CV_32F ? 1e-4 : 1e-10;
+        Mat A(320, 250, depth);
+        cvtest::randUni(rng, A, Scalar::all(-1), Scalar::all(1));
+
+        SVD svd(A);
+        ASSERT_EQ(250, svd.w.rows);
+        Mat W = Mat::diag(svd.w);
+        EXPECT_LE(cvtest::norm(svd.u * W * svd.vt, A, NORM_INF), eps * 10) << "depth=" << depth;
+        EXPECT_LE(cvtest::norm(svd.vt * svd.vt.t(), Mat::eye(250, 250, depth), NORM_INF), eps) << "depth=" << depth;
+        EXPECT_LE(cvtest::norm(svd.u.t() * svd.u, Mat::eye(250, 250, depth), NORM_INF), eps) << "depth=" << depth;
+        for (int i = 1; i < svd.w.rows; i++)
+            ASSERT_GE(depth == CV_32F ? svd.w.at<float>(i - 1) : svd.w.at<double>(i - 1),
+                      depth == CV_32F ? svd.w.at<float>(i) : svd.w.at<double>(i));
+    }
+}
+
+TEST(Core_Invert, large)
+{
+    RNG& rng = cvtest::TS::ptr()->get_rng();
+    const int n = 300;
+    for (int depth = CV_32F; depth <= CV_64F; depth++)
+    {
+        const double eps = depth == CV_32F ? 1e-3 : 1e-10;
+        Mat A(n, n, depth), B, spd;
+        cvtest::randUni(rng, A, Scalar::all(-1), Scalar::all(1));
+        mulTransposed(A, spd, false);
+        spd += Mat::eye(n, n, depth) * n;
+
+        Mat invLU, invChol;
+        invert(A, invLU, DECOMP_LU);
+        invert(spd, invChol, DECOMP_CHOLESKY);
+        EXPECT_LE(cvtest::norm(A * invLU, Mat::eye(n, n, depth), NORM_INF), eps) << "depth=" << depth;
+        EXPECT_LE(cvtest::norm(spd * invChol, Mat::eye(n, n, depth), NORM_INF), eps) << "depth=" << depth;
+
+        // the result does not depend on the number of threads
+        int nthreads = getNumThreads();
+        setNumThreads(1);
+        Mat invLU1, invChol1;
+        invert(A, invLU1, DECOMP_LU);
+        invert(spd, invChol1, DECOMP_CHOLESKY);
+        setNumThreads(nthreads);
+        EXPECT_EQ(0, cvtest::norm(invLU, invLU1, NORM_INF)) << "depth=" << depth;
+        EXPECT_EQ(0, cvtest::norm(invChol, invChol1, NORM_INF)) << "depth=" << depth;
+    }
+}
+
+
+typedef testing::TestWithParam<tuple<int, int> > Core_GEMM_Large;
+
+// sizes of the blocked matrix product exceed the block sizes of the implementation
+TEST_P(Core_GEMM_Large, accuracy)
+{
+    const int depth = get<0>(GetParam());
+    const int flags = get<1>(GetParam());
+    const int M = 150, N = 301, K = 300;
+    RNG& rng = theRNG();
+
+    Size a_size = (flags & GEMM_1_T) ? Size(M, K) : Size(K, M);
+    Size b_size = (flags & GEMM_2_T) ? Size(K, N) : Size(N, K);
+    Size c_size = (flags & GEMM_3_T) ? Size(M, N) : Size(N, M);
+    // non-continuous inputs
+    Mat a_big(a_size.height + 1, a_size.width + 3, depth), b_big(b_size.height + 2, b_size.width + 1, depth);
+    rng.fill(a_big, RNG::UNIFORM, -1, 1);
+    rng.fill(b_big, RNG::UNIFORM, -1, 1);
+    Mat a = a_big(Rect(Point(2, 1), a_size)), b = b_big(Rect(Point(1, 0), b_size));
+    Mat c(c_size, depth);
+    rng.fill(c, RNG::UNIFORM, -1, 1);
+    const double alpha = 0.75, beta = -1.5;
+
+    Mat a64, b64, c64;
+    a.convertTo(a64, CV_64F);
+    b.convertTo(b64, CV_64F);
+    c.convertTo(c64, CV_64F);
+    if (flags & GEMM_1_T)
+        a64 = a64.t();
+    if (flags & GEMM_2_T)
+        b64 = b64.t();
+    if (flags & GEMM_3_T)
+        c64 = c64.t();
+    Mat ref(M, N, CV_64F);
+    for (int i = 0; i < M; i++)
+        for (int j = 0; j < N; j++)
+        {
+            double sum = 0;
+            for (int k = 0; k < K; k++)
+                sum += a64.at<double>(i, k)*b64.at<double>(k, j);
+            ref.at<double>(i, j) = alpha*sum + beta*c64.at<double>(i, j);
+        }
+
+    const double eps = depth == CV_32F ? 1e-3 : 1e-10;
+    Mat dst, dst64;
+    gemm(a, b, alpha, c, beta, dst, flags);
+    ASSERT_EQ(Size(N, M), dst.size());
+    dst.convertTo(dst64, CV_64F);
+    EXPECT_LE(cvtest::norm(ref, dst64, NORM_INF), eps);
+
+    gemm(a, b, alpha, noArray(), 0, dst, flags);
+    dst.convertTo(dst64, CV_64F);
+    ref -= beta*c64;
+    EXPECT_LE(cvtest::norm(ref, dst64, NORM_INF), eps);
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Core_GEMM_Large, testing::Combine(
+    testing::Values(CV_32F, CV_64F),
+    testing::Range(0, 8)));
+
 
 // TODO: eigenvv, invsqrt, cbrt, fastarctan, (round, floor, ceil(?)),
 
@@ -2949,6 +3060,58 @@ TEST(Core_KMeans, compactness)
     }
 }
 
+TEST(Core_KMeans, accelerated)
+{
+    const int N = 4000, dims = 5;
+    const TermCriteria crit = TermCriteria(TermCriteria::COUNT + TermCriteria::EPS, 30, 0);
+    cvtest::TS& ts = *cvtest::TS::ptr();
+    RNG& rng = ts.get_rng();
+    for (int K = 1; K <= 32; K *= 4)
+    {
+        Mat data(N, dims, CV_32F);
+        cvtest::randUni(rng, data, Scalar::all(-100), Scalar::all(100));
+        Mat initialLabels(N, 1, CV_32S);
+        cvtest::randUni(rng, initialLabels, Scalar::all(0), Scalar::all(K));
+
+        Mat labels = initialLabels.clone(), centers;
+        double compactness = kmeans(data, K, labels, crit, 1, KMEANS_USE_INITIAL_LABELS, centers);
+        Mat labels_acc = initialLabels.clone(), centers_acc;
+        double compactness_acc = kmeans(data, K, labels_acc, crit, 1,
+                                        KMEANS_USE_INITIAL_LABELS | KMEANS_ACCELERATED, centers_acc);
+
+        EXPECT_NEAR(compactness, compactness_acc, compactness * 1e-5) << "K=" << K;
+        EXPECT_LE(cvtest::norm(centers, centers_acc, NORM_INF), 1e-2) << "K=" << K;
+        EXPECT_LE(countNonZero(labels != labels_acc), N / 1000) << "K=" << K;
+    }
+}
+
+TEST(Core_KMeans, mini_batch)
+{
+    const int N = 20000, dims = 3, K = 8;
+    cvtest::TS& ts = *cvtest::TS::ptr();
+    RNG& rng = ts.get_rng();
+    Mat data0(K, dims, CV_32F);
+    cvtest::randUni(rng, data0, Scalar::all(-100), Scalar::all(100));
+    Mat data(N, dims, CV_32F);
+    cvtest::randUni(rng, data, Scalar::all(-1), Scalar::all(1));
+    for (int i = 0; i < N; i++)
+        data.row(i) += data0.row(i % K);
+
+    Mat labels, centers;
+    double compactness = kmeans(data, K, labels, TermCriteria(TermCriteria::COUNT, 200, 0), 3,
+                                KMEANS_PP_CENTERS | KMEANS_MINI_BATCH, centers);
+    ASSERT_EQ(labels.rows, N);
+    ASSERT_EQ(centers.rows, K);
+
+    double expected = 0.0;
+    for (int i = 0; i < N; ++i)
+        expected += cvtest::norm(data.row(i), centers.row(labels.at<int>(i)), NORM_L2SQR);
+    EXPECT_NEAR(expected, compactness, expected * 1e-6);
+
+    // the clusters are well separated, so each sample should be close to its center
+    EXPECT_LT(compactness / N, 2.0);
+}
+
 TEST(Core_KMeans, bad_input)
 {
     const int N = 100;
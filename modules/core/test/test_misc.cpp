@@ -250,6 +250,39 @@ TEST(Core_Parallel, propagate_exceptions)
     }, cv::Exception);
 }
 
+class NestedParallelLoopBody : public cv::ParallelLoopBody
+{
+public:
+    NestedParallelLoopBody(cv::Mat& dst) : dst_(dst) {}
+    void operator()(const cv::Range& r) const
+    {
+        for (int i = r.start; i < r.end; i++)
+        {
+            Mat row = dst_.row(i);
+            parallel_for_(cv::Range(0, row.cols), [&](const cv::Range& c) {
+                for (int j = c.start; j < c.end; j++)
+                    row.at<int>(j) += i * row.cols + j;
+            });
+        }
+    }
+protected:
+    Mat dst_;
+};
+
+TEST(Core_Parallel, nested_parallel_for)
+{
+    Mat dst(97, 1013, CV_32SC1, Scalar::all(0));
+    ASSERT_NO_THROW({
+        parallel_for_(cv::Range(0, dst.rows), NestedParallelLoopBody(dst));
+    });
+
+    Mat expected(dst.size(), CV_32SC1);
+    for (int i = 0; i < expected.rows; i++)
+        for (int j = 0; j < expected.cols; j++)
+            expected.at<int>(i, j) = i * expected.cols + j;
+    EXPECT_EQ(0, cvtest::norm(dst, expected, NORM_INF));
+}
+
 class FPDenormalsHintCheckerParallelLoopBody : public cv::ParallelLoopBody
 {
 public:
@@ -1529,6 +1529,133 @@ TEST(Core_sortIdx, regression_8941)
         "expected=" << std::endl << expected;
 }
 
+template<typename T> static void sortReference(const Mat& src, Mat& dst, int flags)
+{
+    bool sortRows = (flags & 1) == SORT_EVERY_ROW;
+    Mat s = sortRows ? src : src.t();
+    Mat d(s.size(), s.type());
+    for (int i = 0; i < s.rows; i++)
+    {
+        std::vector<T> v(s.ptr<T>(i), s.ptr<T>(i) + s.cols);
+        std::sort(v.begin(), v.end());
+        if (flags & SORT_DESCENDING)
+            std::reverse(v.begin(), v.end());
+        std::copy(v.begin(), v.end(), d.ptr<T>(i));
+    }
+    dst = sortRows ? d : d.t();
+}
+
+static void sortReference(const Mat& src, Mat& dst, int flags)
+{
+    switch (src.depth())
+    {
+    case CV_8U: sortReference<uchar>(src, dst, flags); break;
+    case CV_8S: sortReference<schar>(src, dst, flags); break;
+    case CV_16U: sortReference<ushort>(src, dst, flags); break;
+    case CV_16S: sortReference<short>(src, dst, flags); break;
+    case CV_32S: sortReference<int>(src, dst, flags); break;
+    case CV_32F: sortReference<float>(src, dst, flags); break;
+    case CV_64F: sortReference<double>(src, dst, flags); break;
+    default: CV_Error(Error::StsUnsupportedFormat, "");
+    }
+}
+
+TEST(Core_Sort, radix_and_network)
+{
+    // the short rows (columns) use sorting networks, the long ones radix sort
+    const int depths[] = { CV_8U, CV_8S, CV_16U, CV_16S, CV_32S, CV_32F, CV_64F };
+    const Size sizes[] = { Size(2, 37), Size(7, 100), Size(16, 65), Size(17, 40), Size(300, 5), Size(5000, 3) };
+    RNG& rng = theRNG();
+    for (size_t d = 0; d < sizeof(depths)/sizeof(depths[0]); d++)
+        for (size_t s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++)
+            for (int flags = 0; flags < 4; flags++)
+            {
+                Size sz = (flags & 1) == SORT_EVERY_ROW ? sizes[s] : Size(sizes[s].height, sizes[s].width);
+                Mat src(sz, depths[d]), dst, ref;
+                double range = depths[d] >= CV_32F ? 1e5 : 1e9;
+                rng.fill(src, RNG::UNIFORM, -range, range, true);
+                if (depths[d] >= CV_32F)
+                {
+                    // add the duplicates, the zeros of both signs and the infinities
+                    Mat src64;
+                    src.convertTo(src64, CV_64F);
+                    for (int k = 0; k < (int)src.total()/4; k++)
+                    {
+                        const double special[] = { 0., -0., 1., -1., DBL_MAX*2, -DBL_MAX*2 };
+                        src64.at<double>(rng.uniform(0, (int)src.total())) = special[rng.uniform(0, 6)];
+                    }
+                    src64.convertTo(src, depths[d]);
+                }
+
+                cv::sort(src, dst, flags);
+                sortReference(src, ref, flags);
+                EXPECT_EQ(0, countNonZero(dst != ref)) << "depth=" << depths[d] << " size=" << sz << " flags=" << flags;
+
+                // in-place
+                Mat inplace = src.clone();
+                cv::sort(inplace, inplace, flags);
+                EXPECT_EQ(0, countNonZero(inplace != ref)) << "depth=" << depths[d] << " size=" << sz << " flags=" << flags;
+
+                Mat idx, gathered(src.size(), src.type());
+                cv::sortIdx(src, idx, flags);
+                for (int i = 0; i < src.rows; i++)
+                    for (int j = 0; j < src.cols; j++)
+                    {
+                        int k = idx.at<int>(i, j);
+                        Point pt = (flags & 1) == SORT_EVERY_ROW ? Point(k, i) : Point(j, k);
+                        memcpy(gathered.ptr(i, j), src.ptr(pt.y, pt.x), src.elemSize());
+                    }
+                EXPECT_EQ(0, countNonZero(gathered != ref)) << "depth=" << depths[d] << " size=" << sz << " flags=" << flags;
+            }
+}
+
+TEST(Core_Sort, topK)
+{
+    const int depths[] = { CV_8U, CV_16S, CV_32S, CV_32F, CV_64F };
+    RNG& rng = theRNG();
+    for (size_t d = 0; d < sizeof(depths)/sizeof(depths[0]); d++)
+        for (int flags = 0; flags < 4; flags++)
+            for (int k = 1; k <= 1000; k *= 10)
+            {
+                bool sortRows = (flags & 1) == SORT_EVERY_ROW;
+                Mat src(sortRows ? Size(1000, 20) : Size(20, 1000), depths[d]), values, indices;
+                rng.fill(src, RNG::UNIFORM, 0, 50); // many duplicates
+
+                cv::topK(src, values, indices, k, flags);
+                ASSERT_EQ(sortRows ? Size(k, 20) : Size(20, k), values.size());
+                ASSERT_EQ(src.type(), values.type());
+                ASSERT_EQ(values.size(), indices.size());
+                ASSERT_EQ(CV_32SC1, indices.type());
+
+                Mat src64, values64;
+                src.convertTo(src64, CV_64F);
+                values.convertTo(values64, CV_64F);
+                if (!sortRows)
+                {
+                    src64 = src64.t();
+                    values64 = values64.t();
+                    indices = indices.t();
+                }
+                for (int i = 0; i < src64.rows; i++)
+                {
+                    // the reference order: by the value, then by the position
+                    std::vector<std::pair<double, int> > v;
+                    for (int j = 0; j < src64.cols; j++)
+                        v.push_back(std::make_pair((flags & SORT_DESCENDING) ? -src64.at<double>(i, j) : src64.at<double>(i, j), j));
+                    std::sort(v.begin(), v.end());
+                    for (int j = 0; j < k; j++)
+                    {
+                        ASSERT_EQ(v[j].second, indices.at<int>(i, j)) << "depth=" << depths[d] << " flags=" << flags << " k=" << k;
+                        ASSERT_EQ(src64.at<double>(i, v[j].second), values64.at<double>(i, j));
+                    }
+                }
+
+                Mat indicesOnly;
+                cv::topK(src, noArray(), indicesOnly, k, flags);
+                EXPECT_EQ(0, cvtest::norm(indicesOnly, sortRows ? indices : indices.t(), NORM_INF));
+            }
+}
+
 TEST(Core_Mat, augmentation_operations_9688)
 {
     {
@@ -420,4 +420,97 @@ TEST(Core_Rand, parallel_for_stable_results)
     ASSERT_EQ(0, countNonZero(dst1 != dst2));
 }
 
+
+static void checkRandThreadIndependence(int type, int disttype, bool roi)
+{
+    Mat big(700, 1000, type), dst1;
+    Mat a = roi ? big(Rect(7, 3, 901, 617)) : big;
+    int nthreads = cv::getNumThreads();
+
+    cv::setNumThreads(1);
+    RNG rng1(0x12345678);
+    rng1.fill(a, disttype, 1, 50);
+    a.copyTo(dst1);
+    rng1.fill(a, disttype, 1, 50);
+    cv::setNumThreads(nthreads);
+
+    RNG rng2(0x12345678);
+    rng2.fill(a, disttype, 1, 50);
+    EXPECT_EQ(0, cvtest::norm(dst1, a, NORM_INF)) << "type=" << typeToString(type) << " roi=" << roi;
+    rng2.fill(a, disttype, 1, 50);
+    EXPECT_EQ(rng1.state, rng2.state);
+}
+
+TEST(Core_Rand, bulk_fill_thread_count_independence)
+{
+    const int types[] = { CV_8UC1, CV_8UC3, CV_16SC2, CV_32SC1, CV_32FC1, CV_32FC3, CV_64FC1 };
+    for (size_t i = 0; i < sizeof(types)/sizeof(types[0]); i++)
+        for (int roi = 0; roi < 2; roi++)
+        {
+            checkRandThreadIndependence(types[i], RNG::UNIFORM, roi != 0);
+            checkRandThreadIndependence(types[i], RNG::NORMAL, roi != 0);
+        }
+}
+
+TEST(Core_Rand, bulk_randu_same_as_sequential)
+{
+    // the large arrays are generated by blocks, the small ones sequentially
+    const int types[] = { CV_8UC1, CV_16SC1, CV_32FC1, CV_64FC1 };
+    for (size_t i = 0; i < sizeof(types)/sizeof(types[0]); i++)
+    {
+        Mat a(1024, 1024, types[i]), b(a.size(), a.type());
+        RNG rng1(0xdeadbeef), rng2(0xdeadbeef);
+        rng1.fill(a, RNG::UNIFORM, -1000, 1000);
+        for (int y = 0; y < b.rows; y++)
+            rng2.fill(b.row(y), RNG::UNIFORM, -1000, 1000);
+        EXPECT_EQ(0, cvtest::norm(a, b, NORM_INF)) << "type=" << typeToString(types[i]);
+        EXPECT_EQ(rng1.state, rng2.state);
+    }
+}
+
+TEST(Core_Rand, bulk_randn_quality)
+{
+    Mat a(2048, 2048, CV_32FC1);
+    RNG rng(0x87654321);
+    rng.fill(a, RNG::NORMAL, 3, 2);
+
+    Scalar mean, stddev;
+    meanStdDev(a, mean, stddev);
+    EXPECT_NEAR(3, mean[0], 0.01);
+    EXPECT_NEAR(2, stddev[0], 0.01);
+
+    // fraction of values within 1, 2 and 3 sigmas
+    double m1 = countNonZero(abs(a - 3) < 2)/(double)a.total();
+    double m2 = countNonZero(abs(a - 3) < 4)/(double)a.total();
+    double m3 = countNonZero(abs(a - 3) < 6)/(double)a.total();
+    EXPECT_NEAR(0.682689, m1, 0.002);
+    EXPECT_NEAR(0.954500, m2, 0.002);
+    EXPECT_NEAR(0.997300, m3, 0.001);
+}
+
+TEST(Core_Rand, bulk_randShuffle_thread_count_independence)
+{
+    Mat a(1000, 1000, CV_32SC1), b;
+    for (int i = 0; i < (int)a.total(); i++)
+        a.ptr<int>()[i] = i;
+    a.copyTo(b);
+    int nthreads = cv::getNumThreads();
+
+    cv::setNumThreads(1);
+    RNG rng1(0x1234);
+    randShuffle(a, 1, &rng1);
+    cv::setNumThreads(nthreads);
+
+    RNG rng2(0x1234);
+    randShuffle(b, 1, &rng2);
+    EXPECT_EQ(0, cvtest::norm(a, b, NORM_INF));
+    EXPECT_EQ(rng1.state, rng2.state);
+
+    // still a permutation
+    Mat sorted = a.reshape(1, 1).clone();
+    cv::sort(sorted, sorted, SORT_EVERY_ROW + SORT_ASCENDING);
+    for (int i = 0; i < (int)sorted.total(); i++)
+        ASSERT_EQ(i, sorted.at<int>(i));
+}
+
 }} // namespace
@@ -430,6 +430,30 @@ PERF_TEST_P(Size_CvtMode_Bayer, cvtColorBayer8u,
     SANITY_CHECK_NOTHING();
 }
 
+// memory bandwidth bound case, see OPENCV_THREAD_POOL_NUMA for multi-socket systems
+PERF_TEST_P(Size_CvtMode, cvtColor8u_8K,
+            testing::Combine(
+                testing::Values(::perf::sz4320p),
+                testing::Values(CvtMode(COLOR_BGR2GRAY), CvtMode(COLOR_BGR2RGB), CvtMode(COLOR_BGR2YCrCb), CvtMode(CX_BGRA2HSV))
+                )
+            )
+{
+    Size sz = get<0>(GetParam());
+    int mode = get<1>(GetParam());
+    ChPair ch = getConversionInfo(mode);
+    mode %= COLOR_COLORCVT_MAX;
+
+    Mat src(sz, CV_8UC(ch.scn));
+    Mat dst(sz, CV_8UC(ch.dcn));
+
+    declare.time(100);
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE_MULTIRUN(5) cvtColor(src, dst, mode, ch.dcn);
+
+    SANITY_CHECK_NOTHING();
+}
+
 typedef tuple<Size, CvtMode2> Size_CvtMode2_t;
 typedef perf::TestBaseWithParam<Size_CvtMode2_t> Size_CvtMode2;
 
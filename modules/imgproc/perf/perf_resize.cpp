@@ -254,6 +254,29 @@ PERF_TEST_P(MatInfo_Size_Scale_NN, ResizeNN,
     SANITY_CHECK_NOTHING();
 }
 
+// memory bandwidth bound case, see OPENCV_THREAD_POOL_NUMA for multi-socket systems
+PERF_TEST_P(MatInfo_Size_Size, resizeLinear8K,
+            testing::Values(
+                MatInfo_Size_Size_t(CV_8UC3, sz4320p, sz2160p),
+                MatInfo_Size_Size_t(CV_8UC3, sz2160p, sz4320p),
+                MatInfo_Size_Size_t(CV_32FC1, sz4320p, sz2160p),
+                MatInfo_Size_Size_t(CV_32FC1, sz2160p, sz4320p)
+                )
+            )
+{
+    int matType = get<0>(GetParam());
+    Size from = get<1>(GetParam());
+    Size to = get<2>(GetParam());
+
+    cv::Mat src(from, matType), dst(to, matType);
+    declare.in(src, WARMUP_RNG).out(dst);
+    declare.time(100);
+
+    TEST_CYCLE_MULTIRUN(5) resize(src, dst, to, 0, 0, INTER_LINEAR);
+
+    SANITY_CHECK_NOTHING();
+}
+
 PERF_TEST_P(MatInfo_Size_Scale_NN, ResizeNNExact,
     testing::Combine(
         testing::Values(CV_8UC1, CV_8UC3, CV_8UC4),
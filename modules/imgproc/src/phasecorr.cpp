@@ -567,15 +567,20 @@ cv::Point2d cv::phaseCorrelate(InputArray _src1, InputArray _src2, InputArray _w
 
     // execute phase correlation equation
     // Reference: http://en.wikipedia.org/wiki/Phase_correlation
-    dft(padded1, FFT1, DFT_REAL_OUTPUT);
-    dft(padded2, FFT2, DFT_REAL_OUTPUT);
+    // both images are transformed in parallel, plans are reused by subsequent calls of the same size
+    std::vector<Mat> padded(2), spectrums;
+    padded[0] = padded1;
+    padded[1] = padded2;
+    DFTPlan::create(padded1.size(), padded1.type(), DFT_REAL_OUTPUT)->executeBatch(padded, spectrums);
+    FFT1 = spectrums[0];
+    FFT2 = spectrums[1];
 
     mulSpectrums(FFT1, FFT2, P, 0, true);
 
     magSpectrums(P, Pm);
     divSpectrums(P, Pm, C, 0, false); // FF* / |FF*| (phase correlation equation completed here...)
 
-    idft(C, C); // gives us the nice peak shift location...
+    DFTPlan::create(C.size(), C.type(), DFT_INVERSE)->execute(C, C); // gives us the nice peak shift location...
 
     fftShift(C); // shift the energy to the center of the frame.
 
@@ -626,7 +626,7 @@ void crossCorr( const Mat& img, const Mat& _templ, Mat& corr,
 
     buf.resize(bufSize);
 
-    Ptr<hal::DFT2D> c = hal::DFT2D::create(dftsize.width, dftsize.height, dftTempl.depth(), 1, 1, CV_HAL_DFT_IS_INPLACE, templ.rows);
+    Ptr<DFTPlan> c = DFTPlan::create(dftsize, dftTempl.depth(), 0, templ.rows);
 
     // compute DFT of each template plane
     for( k = 0; k < tcn; k++ )
@@ -651,7 +651,7 @@ void crossCorr( const Mat& img, const Mat& _templ, Mat& corr,
             Mat part(dst, Range(0, templ.rows), Range(templ.cols, dst.cols));
             part = Scalar::all(0);
         }
-        c->apply(dst.data, (int)dst.step, dst.data, (int)dst.step);
+        c->execute(dst, dst);
     }
 
     int tileCountX = (corr.cols + blocksize.width - 1)/blocksize.width;
@@ -670,11 +670,10 @@ void crossCorr( const Mat& img, const Mat& _templ, Mat& corr,
     }
     borderType |= BORDER_ISOLATED;
 
-    Ptr<hal::DFT2D> cF, cR;
-    int f = CV_HAL_DFT_IS_INPLACE;
-    int f_inv = f | CV_HAL_DFT_INVERSE | CV_HAL_DFT_SCALE;
-    cF = hal::DFT2D::create(dftsize.width, dftsize.height, maxDepth, 1, 1, f, blocksize.height + templ.rows - 1);
-    cR = hal::DFT2D::create(dftsize.width, dftsize.height, maxDepth, 1, 1, f_inv, blocksize.height);
+    // the last row of tiles may be shorter, it has own plans
+    Ptr<DFTPlan> cF = DFTPlan::create(dftsize, maxDepth, 0, blocksize.height + templ.rows - 1);
+    Ptr<DFTPlan> cR = DFTPlan::create(dftsize, maxDepth, DFT_INVERSE + DFT_SCALE, blocksize.height);
+    Ptr<DFTPlan> cF1, cR1;
 
     // calculate correlation by blocks
     for( i = 0; i < tileCount; i++ )
@@ -713,19 +712,19 @@ void crossCorr( const Mat& img, const Mat& _templ, Mat& corr,
                 copyMakeBorder(dst1, dst, y1-y0, dst.rows-dst1.rows-(y1-y0),
                                x1-x0, dst.cols-dst1.cols-(x1-x0), borderType);
 
-            if (bsz.height == blocksize.height)
-                cF->apply(dftImg.data, (int)dftImg.step, dftImg.data, (int)dftImg.step);
-            else
-                dft( dftImg, dftImg, 0, dsz.height );
+            if (bsz.height != blocksize.height && !cF1)
+            {
+                cF1 = DFTPlan::create(dftsize, maxDepth, 0, dsz.height);
+                cR1 = DFTPlan::create(dftsize, maxDepth, DFT_INVERSE + DFT_SCALE, bsz.height);
+            }
+
+            (bsz.height == blocksize.height ? cF : cF1)->execute(dftImg, dftImg);
 
             Mat dftTempl1(dftTempl, Rect(0, tcn > 1 ? k*dftsize.height : 0,
                                          dftsize.width, dftsize.height));
             mulSpectrums(dftImg, dftTempl1, dftImg, 0, true);
 
-            if (bsz.height == blocksize.height)
-                cR->apply(dftImg.data, (int)dftImg.step, dftImg.data, (int)dftImg.step);
-            else
-                dft( dftImg, dftImg, DFT_INVERSE + DFT_SCALE, bsz.height );
+            (bsz.height == blocksize.height ? cR : cR1)->execute(dftImg, dftImg);
 
             src = dftImg(Rect(0, 0, bsz.width, bsz.height));
 